@@ -67,6 +67,7 @@
 #endif
 #include <utility>
 #include <type_traits>
+#include <vector>
 
 #ifdef __GNUC__
 # pragma GCC diagnostic push
@@ -5976,6 +5977,381 @@ to_stream(std::basic_ostream<CharT, Traits>& os, const CharT* fmt,
     return to_stream(os, fmt, fds, &abbrev, &offset);
 }
 
+// compiled_format
+
+namespace detail
+{
+
+// Splits fmt into literal characters, passed to literal(c), and commands, passed to
+// command(first, last, command, modified) with the command's characters in
+// [first, last).  %n, %t and %% are literal.  A % at the end of fmt, perhaps with a
+// modifier, is a command of its own named '%'.
+template <class CharT, class Literal, class Command>
+void
+split_format(const CharT* fmt, Literal literal, Command command)
+{
+    for (auto p = fmt; *p;)
+    {
+        if (*p != CharT{'%'})
+        {
+            literal(*p++);
+            continue;
+        }
+        auto const first = p++;
+        CharT modified{};
+        if (*p == CharT{'E'} || *p == CharT{'O'})
+            modified = *p++;
+        if (*p == CharT{})
+        {
+            command(first, p, CharT{'%'}, modified);
+            return;
+        }
+        auto const c = *p++;
+        if (modified == CharT{} && c == CharT{'n'})
+            literal(CharT{'\n'});
+        else if (modified == CharT{} && c == CharT{'t'})
+            literal(CharT{'\t'});
+        else if (modified == CharT{} && c == CharT{'%'})
+            literal(CharT{'%'});
+        else
+            command(first, p, c, modified);
+    }
+}
+
+template <class CharT>
+CharT*
+put_digits(CharT* p, unsigned long long x, unsigned width)
+{
+    CharT tmp[20];
+    unsigned n = 0;
+    do
+    {
+        tmp[n++] = static_cast<CharT>('0' + x % 10);
+        x /= 10;
+    } while (x != 0);
+    for (; width > n; --width)
+        *p++ = CharT{'0'};
+    while (n > 0)
+        *p++ = tmp[--n];
+    return p;
+}
+
+template <class CharT, class Duration>
+CharT*
+put_seconds(CharT* p, const hh_mm_ss<Duration>& tod, std::false_type)
+{
+    p = put_digits(p, static_cast<unsigned long long>(tod.seconds().count()), 2);
+    if (hh_mm_ss<Duration>::fractional_width > 0)
+    {
+        *p++ = CharT{'.'};
+        p = put_digits(p, static_cast<unsigned long long>(tod.subseconds().count()),
+                       hh_mm_ss<Duration>::fractional_width);
+    }
+    return p;
+}
+
+template <class CharT, class Duration>
+CharT*
+put_seconds(CharT*, const hh_mm_ss<Duration>&, std::true_type)
+{
+    return nullptr;
+}
+
+// Writes what to_stream writes for command in the classic locale to p, which has room
+// for 64 characters, and returns the end of it.  Returns nullptr if to_stream has to
+// handle the command:  it isn't one of %Y %m %d %e %y %F %H %M %S %T %R %z, or the
+// fields it needs are missing or invalid.  %Z is left to the caller.
+template <class CharT, class Duration>
+CharT*
+put_field(CharT* p, CharT command, CharT modified, const fields<Duration>& fds,
+          const std::chrono::seconds* offset_sec)
+{
+    using std::chrono::duration_cast;
+    using std::chrono::hours;
+    using std::chrono::minutes;
+    using rep = typename hh_mm_ss<Duration>::precision::rep;
+    using is_float = std::chrono::treat_as_floating_point<rep>;
+    if (modified != CharT{} && command != CharT{'z'})
+        return nullptr;
+    auto const& ymd = fds.ymd;
+    auto const& tod = fds.tod;
+    auto const y = static_cast<int>(ymd.year());
+    switch (command)
+    {
+    case 'Y':
+    case 'F':
+        if (!ymd.year().ok() || y < 0 || y > 9999)
+            return nullptr;
+        if (command == CharT{'F'} && !ymd.ok())
+            return nullptr;
+        p = put_digits(p, static_cast<unsigned>(y), 4);
+        if (command == CharT{'F'})
+        {
+            *p++ = CharT{'-'};
+            p = put_digits(p, static_cast<unsigned>(ymd.month()), 2);
+            *p++ = CharT{'-'};
+            p = put_digits(p, static_cast<unsigned>(ymd.day()), 2);
+        }
+        return p;
+    case 'y':
+        if (!ymd.year().ok())
+            return nullptr;
+        return put_digits(p, static_cast<unsigned>(std::abs(y) % 100), 2);
+    case 'm':
+        if (!ymd.month().ok())
+            return nullptr;
+        return put_digits(p, static_cast<unsigned>(ymd.month()), 2);
+    case 'd':
+    case 'e':
+        if (!ymd.day().ok())
+            return nullptr;
+        if (command == CharT{'e'} && ymd.day() < day{10})
+            *p++ = CharT{' '};
+        return put_digits(p, static_cast<unsigned>(ymd.day()), command == CharT{'d'} ? 2 : 1);
+    case 'H':
+    case 'M':
+    case 'S':
+    case 'T':
+    case 'R':
+        if (!fds.has_tod || tod.is_negative())
+            return nullptr;
+        if (command == CharT{'M'})
+            return put_digits(p, static_cast<unsigned>(tod.minutes().count()), 2);
+        if (command == CharT{'S'})
+            return put_seconds(p, tod, is_float{});
+        p = put_digits(p, static_cast<unsigned long long>(tod.hours().count()), 2);
+        if (command == CharT{'H'})
+            return p;
+        *p++ = CharT{':'};
+        p = put_digits(p, static_cast<unsigned>(tod.minutes().count()), 2);
+        if (command == CharT{'R'})
+            return p;
+        *p++ = CharT{':'};
+        return put_seconds(p, tod, is_float{});
+    case 'z':
+        if (offset_sec == nullptr)
+            return nullptr;
+        {
+            auto m = duration_cast<minutes>(*offset_sec);
+            *p++ = m < minutes{0} ? CharT{'-'} : CharT{'+'};
+            m = date::abs(m);
+            auto h = duration_cast<hours>(m);
+            m -= h;
+            p = put_digits(p, static_cast<unsigned long long>(h.count()), 2);
+            if (modified != CharT{})
+                *p++ = CharT{':'};
+            return put_digits(p, static_cast<unsigned>(m.count()), 2);
+        }
+    }
+    return nullptr;
+}
+
+// Formats fds with fmt through a stream in the classic locale, as format does, and
+// copies the result to out.
+template <class CharT, class Traits, class OutputIt, class Duration>
+OutputIt
+stream_fields_to(OutputIt out, const CharT* fmt, const fields<Duration>& fds,
+                 const std::string* abbrev, const std::chrono::seconds* offset_sec)
+{
+    std::basic_ostringstream<CharT, Traits> os;
+    os.exceptions(std::ios::failbit | std::ios::badbit);
+    os.imbue(std::locale::classic());
+    to_stream(os, fmt, fds, abbrev, offset_sec);
+    auto const s = os.str();
+    return std::copy(s.begin(), s.end(), out);
+}
+
+// Writes the command in [first, last) to out, without a stream if put_field can.
+template <class CharT, class Traits, class OutputIt, class Duration>
+OutputIt
+command_to(OutputIt out, const CharT* first, const CharT* last, CharT command,
+           CharT modified, const fields<Duration>& fds, const std::string* abbrev,
+           const std::chrono::seconds* offset_sec)
+{
+    if (command == CharT{'Z'} && modified == CharT{} && abbrev != nullptr)
+    {
+        for (auto c : *abbrev)
+            *out++ = CharT(c);
+        return out;
+    }
+    CharT buf[64];
+    if (auto e = put_field(buf, command, modified, fds, offset_sec))
+        return std::copy(buf, e, out);
+    CharT f[4] = {};
+    std::copy(first, last, f);
+    return stream_fields_to<CharT, Traits>(out, f, fds, abbrev, offset_sec);
+}
+
+}  // namespace detail
+
+// A format string parsed once, for formatting many values with the same format.  The
+// format is split into runs of literal text, with %n, %t and %% already expanded, and
+// single commands.  When the stream has the classic locale the common numeric commands
+// (%Y %m %d %e %y %F %H %M %S %T %R %z %Z) are written directly, and every other
+// command is handed to to_stream on its own, so the output is always what to_stream
+// gives for the whole format.
+
+template <class CharT, class Traits = std::char_traits<CharT>>
+class compiled_format
+{
+    struct op
+    {
+        CharT         command;   // CharT{} for literal text
+        CharT         modified;
+        std::uint32_t pos;       // into buf_
+        std::uint32_t len;
+    };
+
+    std::basic_string<CharT, Traits> fmt_;
+    // The literal runs, and each command followed by a null so that it can be handed
+    // to to_stream.
+    std::basic_string<CharT, Traits> buf_;
+    std::vector<op>                  ops_;
+
+public:
+    explicit compiled_format(const CharT* fmt)
+        : fmt_(fmt)
+    {
+        detail::split_format(fmt_.c_str(),
+            [this](CharT c)
+            {
+                if (ops_.empty() || ops_.back().command != CharT{})
+                    ops_.push_back(op{CharT{}, CharT{},
+                                      static_cast<std::uint32_t>(buf_.size()), 0});
+                buf_ += c;
+                ++ops_.back().len;
+            },
+            [this](const CharT* first, const CharT* last, CharT command, CharT modified)
+            {
+                ops_.push_back(op{command, modified, static_cast<std::uint32_t>(buf_.size()),
+                                  static_cast<std::uint32_t>(last - first)});
+                buf_.append(first, last);
+                buf_ += CharT{};
+            });
+    }
+
+    template <class Alloc>
+    explicit compiled_format(const std::basic_string<CharT, Traits, Alloc>& fmt)
+        : compiled_format(fmt.c_str())
+        {}
+
+    const CharT* c_str() const NOEXCEPT {return fmt_.c_str();}
+
+    template <class Duration>
+    std::basic_ostream<CharT, Traits>&
+    to_stream(std::basic_ostream<CharT, Traits>& os, const fields<Duration>& fds,
+              const std::string* abbrev = nullptr,
+              const std::chrono::seconds* offset_sec = nullptr) const
+    {
+        // A negative time of day puts its sign before the first of %H, %I, %M or %S
+        if (fds.has_tod && fds.tod.is_negative())
+            return date::to_stream(os, fmt_.c_str(), fds, abbrev, offset_sec);
+        date::detail::save_ostream<CharT, Traits> ss(os);
+        os.fill(' ');
+        os.flags(std::ios::skipws | std::ios::dec);
+        os.width(0);
+        const bool direct = os.getloc() == std::locale::classic();
+        for (auto const& o : ops_)
+        {
+            auto const s = buf_.data() + o.pos;
+            if (o.command == CharT{})
+            {
+                os.write(s, static_cast<std::streamsize>(o.len));
+                continue;
+            }
+            if (direct)
+            {
+                if (o.command == CharT{'Z'} && o.modified == CharT{} && abbrev != nullptr)
+                {
+                    for (auto c : *abbrev)
+                        os.put(CharT(c));
+                    continue;
+                }
+                CharT out[64];
+                if (auto e = detail::put_field(out, o.command, o.modified, fds, offset_sec))
+                {
+                    os.write(out, e - out);
+                    continue;
+                }
+            }
+            date::to_stream(os, s, fds, abbrev, offset_sec);
+            if (os.fail())
+                return os;
+        }
+        return os;
+    }
+
+    // As to_stream with the classic locale, writing to out.  Only commands that
+    // to_stream would have to handle go through a stream.
+    template <class OutputIt, class Duration>
+    OutputIt
+    format_to(OutputIt out, const fields<Duration>& fds, const std::string* abbrev = nullptr,
+              const std::chrono::seconds* offset_sec = nullptr) const
+    {
+        if (fds.has_tod && fds.tod.is_negative())
+            return detail::stream_fields_to<CharT, Traits>(out, fmt_.c_str(), fds, abbrev,
+                                                           offset_sec);
+        for (auto const& o : ops_)
+        {
+            auto const s = buf_.data() + o.pos;
+            if (o.command == CharT{})
+                out = std::copy(s, s + o.len, out);
+            else
+                out = detail::command_to<CharT, Traits>(out, s, s + o.len, o.command,
+                                                        o.modified, fds, abbrev,
+                                                        offset_sec);
+        }
+        return out;
+    }
+};
+
+template <class CharT, class Traits, class Duration>
+inline
+std::basic_ostream<CharT, Traits>&
+to_stream(std::basic_ostream<CharT, Traits>& os, const compiled_format<CharT, Traits>& fmt,
+          const fields<Duration>& fds, const std::string* abbrev = nullptr,
+          const std::chrono::seconds* offset_sec = nullptr)
+{
+    return fmt.to_stream(os, fds, abbrev, offset_sec);
+}
+
+template <class CharT, class Traits, class Duration>
+std::basic_ostream<CharT, Traits>&
+to_stream(std::basic_ostream<CharT, Traits>& os, const compiled_format<CharT, Traits>& fmt,
+          const local_time<Duration>& tp, const std::string* abbrev = nullptr,
+          const std::chrono::seconds* offset_sec = nullptr)
+{
+    using CT = typename std::common_type<Duration, std::chrono::seconds>::type;
+    auto ld = floor<days>(tp);
+    fields<CT> fds{year_month_day{ld}, hh_mm_ss<CT>{tp-local_seconds{ld}}};
+    return fmt.to_stream(os, fds, abbrev, offset_sec);
+}
+
+template <class CharT, class Traits, class Duration>
+std::basic_ostream<CharT, Traits>&
+to_stream(std::basic_ostream<CharT, Traits>& os, const compiled_format<CharT, Traits>& fmt,
+          const sys_time<Duration>& tp)
+{
+    using std::chrono::seconds;
+    using CT = typename std::common_type<Duration, seconds>::type;
+    const std::string abbrev("UTC");
+    CONSTDATA seconds offset{0};
+    auto sd = floor<days>(tp);
+    fields<CT> fds{year_month_day{sd}, hh_mm_ss<CT>{tp-sys_seconds{sd}}};
+    return fmt.to_stream(os, fds, &abbrev, &offset);
+}
+
+// Everything else that to_stream formats goes through the format string.
+template <class CharT, class Traits, class Streamable>
+inline
+auto
+to_stream(std::basic_ostream<CharT, Traits>& os, const compiled_format<CharT, Traits>& fmt,
+          const Streamable& x)
+    -> decltype(to_stream(os, fmt.c_str(), x))
+{
+    return to_stream(os, fmt.c_str(), x);
+}
+
 // format
 
 template <class CharT, class Streamable>
@@ -6029,6 +6405,177 @@ format(const std::basic_string<CharT, Traits, Alloc>& fmt, const Streamable& tp)
     return os.str();
 }
 
+template <class CharT, class Traits, class Streamable>
+auto
+format(const std::locale& loc, const compiled_format<CharT, Traits>& fmt,
+       const Streamable& tp)
+    -> decltype(to_stream(std::declval<std::basic_ostream<CharT, Traits>&>(), fmt, tp),
+                std::basic_string<CharT, Traits>{})
+{
+    std::basic_ostringstream<CharT, Traits> os;
+    os.exceptions(std::ios::failbit | std::ios::badbit);
+    os.imbue(loc);
+    to_stream(os, fmt, tp);
+    return os.str();
+}
+
+template <class CharT, class Traits, class Streamable>
+auto
+format(const compiled_format<CharT, Traits>& fmt, const Streamable& tp)
+    -> decltype(to_stream(std::declval<std::basic_ostream<CharT, Traits>&>(), fmt, tp),
+                std::basic_string<CharT, Traits>{})
+{
+    std::basic_ostringstream<CharT, Traits> os;
+    os.exceptions(std::ios::failbit | std::ios::badbit);
+    to_stream(os, fmt, tp);
+    return os.str();
+}
+
+// format_to
+
+namespace detail
+{
+
+template <class OutputIt, class CharT, class Duration>
+OutputIt
+fields_to(OutputIt out, const CharT* fmt, const fields<Duration>& fds,
+          const std::string* abbrev, const std::chrono::seconds* offset_sec)
+{
+    using Traits = std::char_traits<CharT>;
+    if (fds.has_tod && fds.tod.is_negative())
+        return stream_fields_to<CharT, Traits>(out, fmt, fds, abbrev, offset_sec);
+    split_format(fmt,
+        [&out](CharT c)
+        {
+            *out++ = c;
+        },
+        [&](const CharT* first, const CharT* last, CharT command, CharT modified)
+        {
+            out = command_to<CharT, Traits>(out, first, last, command, modified, fds,
+                                            abbrev, offset_sec);
+        });
+    return out;
+}
+
+template <class OutputIt, class CharT, class Traits, class Alloc, class Duration>
+inline
+OutputIt
+fields_to(OutputIt out, const std::basic_string<CharT, Traits, Alloc>& fmt,
+          const fields<Duration>& fds, const std::string* abbrev,
+          const std::chrono::seconds* offset_sec)
+{
+    return fields_to(out, fmt.c_str(), fds, abbrev, offset_sec);
+}
+
+template <class OutputIt, class CharT, class Traits, class Duration>
+inline
+OutputIt
+fields_to(OutputIt out, const compiled_format<CharT, Traits>& fmt,
+          const fields<Duration>& fds, const std::string* abbrev,
+          const std::chrono::seconds* offset_sec)
+{
+    return fmt.format_to(out, fds, abbrev, offset_sec);
+}
+
+// An output iterator that stores at most n characters from p on, and counts all of
+// the characters written to it.
+template <class OutputIt>
+struct truncating_iterator
+{
+    using iterator_category = std::output_iterator_tag;
+    using value_type        = void;
+    using difference_type   = std::ptrdiff_t;
+    using pointer           = void;
+    using reference         = void;
+
+    OutputIt       p;
+    std::size_t    n;
+    std::ptrdiff_t count;
+
+    truncating_iterator& operator*() {return *this;}
+    truncating_iterator& operator++() {return *this;}
+    truncating_iterator& operator++(int) {return *this;}
+
+    template <class CharT>
+    truncating_iterator&
+    operator=(CharT c)
+    {
+        if (n > 0)
+        {
+            *p++ = c;
+            --n;
+        }
+        ++count;
+        return *this;
+    }
+};
+
+}  // namespace detail
+
+// format_to writes what format gives with the classic locale to out, and returns the
+// end of it.  fmt is a format string or a compiled_format.  For sys_time, local_time
+// and zoned_time the common numeric commands (%Y %m %d %e %y %F %H %M %S %T %R %z %Z)
+// and literal text are written directly, without a stream or any allocation.  Other
+// commands, and other types, are formatted through a stream.  Throws
+// std::ios_base::failure where format would.
+
+template <class OutputIt, class Format, class Duration>
+auto
+format_to(OutputIt out, const Format& fmt, const local_time<Duration>& tp)
+    -> decltype(detail::fields_to(out, fmt,
+                    fields<typename std::common_type<Duration, std::chrono::seconds>::type>{},
+                    nullptr, nullptr))
+{
+    using CT = typename std::common_type<Duration, std::chrono::seconds>::type;
+    auto ld = floor<days>(tp);
+    fields<CT> fds{year_month_day{ld}, hh_mm_ss<CT>{tp-local_seconds{ld}}};
+    return detail::fields_to(out, fmt, fds, nullptr, nullptr);
+}
+
+template <class OutputIt, class Format, class Duration>
+auto
+format_to(OutputIt out, const Format& fmt, const sys_time<Duration>& tp)
+    -> decltype(detail::fields_to(out, fmt,
+                    fields<typename std::common_type<Duration, std::chrono::seconds>::type>{},
+                    nullptr, nullptr))
+{
+    using std::chrono::seconds;
+    using CT = typename std::common_type<Duration, seconds>::type;
+    static const std::string abbrev("UTC");
+    CONSTDATA seconds offset{0};
+    auto sd = floor<days>(tp);
+    fields<CT> fds{year_month_day{sd}, hh_mm_ss<CT>{tp-sys_seconds{sd}}};
+    return detail::fields_to(out, fmt, fds, &abbrev, &offset);
+}
+
+template <class OutputIt, class Format, class Streamable>
+auto
+format_to(OutputIt out, const Format& fmt, const Streamable& tp)
+    -> decltype(format(std::locale::classic(), fmt, tp), OutputIt(out))
+{
+    auto const s = format(std::locale::classic(), fmt, tp);
+    return std::copy(s.begin(), s.end(), out);
+}
+
+template <class OutputIt>
+struct format_to_n_result
+{
+    OutputIt       out;
+    std::ptrdiff_t size;
+};
+
+// As format_to, but writes at most n characters.  Returns the end of what was
+// written, and the size the whole output would have had.
+template <class OutputIt, class Format, class Streamable>
+auto
+format_to_n(OutputIt out, std::size_t n, const Format& fmt, const Streamable& tp)
+    -> decltype(format_to(detail::truncating_iterator<OutputIt>{out, n, 0}, fmt, tp),
+                format_to_n_result<OutputIt>{})
+{
+    auto r = format_to(detail::truncating_iterator<OutputIt>{out, n, 0}, fmt, tp);
+    return {r.p, r.count};
+}
+
 // parse
 
 namespace detail
@@ -479,9 +479,10 @@ read_date(const string_t& s, unsigned i, rule& r)
         throw_invalid(s, i, "Expected 'J', 'M', or a digit to start rule");
     if (i != s.size() && s[i] == '/')
     {
+        // RFC 8536 allows the time of day to be negative, and up to 167 hours
         ++i;
         std::chrono::seconds t;
-        i = read_unsigned_time(s, i, t);
+        i = read_signed_time(s, i, t);
         r.time_ = t;
     }
     return i;
@@ -552,7 +553,7 @@ read_unsigned_time(const string_t& s, unsigned i, std::chrono::seconds& t)
     if (i == s.size())
         throw_invalid(s, i, "Expected to read unsigned time, but found end of string");
     unsigned x;
-    i = read_unsigned(s, i, 2, x);
+    i = read_unsigned(s, i, 3, x);
     t = hours{x};
     if (i != s.size() && s[i] == ':')
     {
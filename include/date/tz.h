@@ -82,6 +82,18 @@ static_assert(HAS_REMOTE_API == 0 ? AUTO_DOWNLOAD == 0 : true,
 #  define USE_SHELL_API 1
 #endif
 
+#ifndef USE_INFO_CACHE
+#  define USE_INFO_CACHE 0
+#endif
+
+#ifndef USE_TZDB_WATCHER
+#  define USE_TZDB_WATCHER 0
+#endif
+
+#if USE_TZDB_WATCHER && !defined(__linux__)
+#  error "USE_TZDB_WATCHER requires inotify, which is only available on Linux"
+#endif
+
 #if USE_OS_TZDB
 #  ifdef _WIN32
 #    error "USE_OS_TZDB can not be used on Windows"
@@ -115,7 +127,10 @@ static_assert(HAS_REMOTE_API == 0 ? AUTO_DOWNLOAD == 0 : true,
 #include <atomic>
 #include <cassert>
 #include <chrono>
+#include <cstring>
+#include <functional>
 #include <istream>
+#include <iterator>
 #include <locale>
 #include <memory>
 #include <mutex>
@@ -207,6 +222,71 @@ operator<<(std::basic_ostream<CharT, Traits>& os, const local_info& r)
     return os;
 }
 
+#if HAS_STRING_VIEW
+
+// sys_info and local_info with the abbreviation held as a string_view into storage
+// owned by the database, so that producing one never allocates.  The abbreviation
+// stays valid for as long as the tzdb that the time_zone came from.
+
+struct sys_info_view
+{
+    sys_seconds          begin;
+    sys_seconds          end;
+    std::chrono::seconds offset;
+    std::chrono::minutes save;
+    std::string_view     abbrev;
+};
+
+template<class CharT, class Traits>
+std::basic_ostream<CharT, Traits>&
+operator<<(std::basic_ostream<CharT, Traits>& os, const sys_info_view& r)
+{
+    os << r.begin << '\n';
+    os << r.end << '\n';
+    os << make_time(r.offset) << "\n";
+    os << make_time(r.save) << "\n";
+    os << r.abbrev << '\n';
+    return os;
+}
+
+struct local_info_view
+{
+    enum {unique, nonexistent, ambiguous} result;
+    sys_info_view first;
+    sys_info_view second;
+};
+
+template<class CharT, class Traits>
+std::basic_ostream<CharT, Traits>&
+operator<<(std::basic_ostream<CharT, Traits>& os, const local_info_view& r)
+{
+    if (r.result == local_info_view::nonexistent)
+        os << "nonexistent between\n";
+    else if (r.result == local_info_view::ambiguous)
+        os << "ambiguous between\n";
+    os << r.first;
+    if (r.result != local_info_view::unique)
+    {
+        os << "and\n";
+        os << r.second;
+    }
+    return os;
+}
+
+// A change in a time_zone's offset, save or abbreviation, as produced by
+// time_zone::transitions.  abbrev is valid as long as it is in sys_info_view.
+
+struct zone_transition
+{
+    sys_seconds          when;
+    std::chrono::seconds old_offset;
+    std::chrono::seconds new_offset;
+    std::chrono::minutes save;
+    std::string_view     abbrev;
+};
+
+#endif  // HAS_STRING_VIEW
+
 class nonexistent_local_time
     : public std::runtime_error
 {
@@ -771,14 +851,66 @@ namespace detail
 #  if USE_OS_TZDB
     struct transition;
     struct expanded_ttinfo;
+    struct posix_footer;
 #  else  // !USE_OS_TZDB
     struct zonelet;
     class Rule;
+    class line_reader;
+    struct snapshot;
 #  endif  // !USE_OS_TZDB
 }
 
 #endif  // !defined(_MSC_VER) || (_MSC_VER >= 1900)
 
+namespace detail
+{
+
+// A time_zone's UTC offset on each day of a range of years, built by
+// tzdb::materialize.  Each entry is the offset in seconds times 2, plus 1 if the
+// offset changes during that UTC day.
+struct day_table
+{
+    sys_days                  first;
+    std::vector<std::int32_t> entries;
+};
+
+// A day table that tzdb::materialize was asked for.
+struct materialize_request
+{
+    std::string name;
+    year        first;
+    year        last;
+};
+
+// The parts of a time_zone that change after it is built.  once guards its one time
+// initialization, and done is set after that so that it can be queried without
+// blocking.  days is the day table in use, if any.  Tables that have been replaced
+// are kept in tables until the zone is destroyed, since readers may still be using
+// them.
+struct zone_state
+{
+    std::once_flag                                once;
+    std::atomic<bool>                             done{false};
+    std::atomic<const day_table*>                 days{nullptr};
+    std::vector<std::unique_ptr<const day_table>> tables;
+};
+
+}  // namespace detail
+
+#if !USE_OS_TZDB
+
+struct tzdb;
+
+namespace detail
+{
+
+// Points each of db's zones at db.rules.  Called once db has its final rules.
+void bind_rules(tzdb& db);
+
+}  // namespace detail
+
+#endif  // !USE_OS_TZDB
+
 class time_zone
 {
 private:
@@ -786,10 +918,30 @@ private:
 #if USE_OS_TZDB
     std::vector<detail::transition>      transitions_;
     std::vector<detail::expanded_ttinfo> ttinfos_;
+    // Search index over transitions_, built by init_impl.  The keys are laid out in
+    // Eytzinger (breadth first) order starting at slot 1, and key_index_ maps each
+    // slot back to its position in transitions_.
+    std::vector<sys_seconds>             sys_keys_;
+    std::vector<local_seconds>           local_keys_;
+    std::vector<std::uint32_t>           key_index_;
+    // The rule from the file's footer, which takes over after the last transition.
+    std::shared_ptr<const detail::posix_footer> footer_;
 #else  // !USE_OS_TZDB
     std::vector<detail::zonelet>         zonelets_;
+    std::vector<sys_info>                compiled_;
+    // The rules of the tzdb holding this zone.  Its zonelets point into them.
+    const std::vector<detail::Rule>*     rules_ = nullptr;
+    // For a zone loaded from a tzdb snapshot, its adjusted zonelets and compiled table
+    // as stored in the mapped file, which init decodes.  Null otherwise.
+    const char*                          snapshot_first_ = nullptr;
+    const char*                          snapshot_last_ = nullptr;
+#if HAS_STRING_VIEW
+    // Every abbreviation that walk_rules can give for this zone, sorted.  Views of
+    // periods outside of compiled_ point into these.
+    std::vector<std::string>             abbrevs_;
+#endif
 #endif  // !USE_OS_TZDB
-    std::unique_ptr<std::once_flag>      adjusted_;
+    std::unique_ptr<detail::zone_state>  adjusted_;
 
 public:
 #if !defined(_MSC_VER) || (_MSC_VER >= 1900)
@@ -801,12 +953,30 @@ public:
 #endif  // defined(_MSC_VER) && (_MSC_VER < 1900)
 
     DATE_API explicit time_zone(const std::string& s, detail::undocumented);
+#if !USE_OS_TZDB
+    DATE_API explicit time_zone(detail::line_reader in, detail::undocumented);
+#endif
 
     const std::string& name() const NOEXCEPT;
 
+    // True once this zone has been loaded and is ready to answer get_info without
+    // further work.  See tzdb::prewarm.
+    bool is_initialized() const NOEXCEPT;
+
     template <class Duration> sys_info   get_info(sys_time<Duration> st) const;
     template <class Duration> local_info get_info(local_time<Duration> tp) const;
 
+#if HAS_STRING_VIEW
+    template <class Duration> sys_info_view   get_info_view(sys_time<Duration> st) const;
+    template <class Duration> local_info_view get_info_view(local_time<Duration> tp) const;
+
+    // The transitions with from <= when < to, in order.  Each step moves straight on
+    // to the next period in the zone's data, rather than searching for it afresh.
+    class transition_iterator;
+    class transition_range;
+    transition_range transitions(sys_seconds from, sys_seconds to) const;
+#endif
+
     template <class Duration>
         sys_time<typename std::common_type<Duration, std::chrono::seconds>::type>
         to_sys(local_time<Duration> tp) const;
@@ -819,17 +989,53 @@ public:
         local_time<typename std::common_type<Duration, std::chrono::seconds>::type>
         to_local(sys_time<Duration> tp) const;
 
+    // Range versions of the above.  These are much faster than converting one time
+    // point at a time when the input is (mostly) sorted.
+    template <class InputIterator, class OutputIterator>
+        OutputIterator
+        to_local(InputIterator first, InputIterator last, OutputIterator result) const;
+
+    template <class InputIterator, class OutputIterator>
+        OutputIterator
+        to_sys(InputIterator first, InputIterator last, OutputIterator result) const;
+
+    template <class InputIterator, class OutputIterator>
+        OutputIterator
+        to_sys(InputIterator first, InputIterator last, OutputIterator result,
+               choose z) const;
+
+    // Writes the UTC offset in effect at each sys_time in [first, last).
+    template <class InputIterator, class OutputIterator>
+        OutputIterator
+        get_offsets(InputIterator first, InputIterator last, OutputIterator result) const;
+
     friend bool operator==(const time_zone& x, const time_zone& y) NOEXCEPT;
     friend bool operator< (const time_zone& x, const time_zone& y) NOEXCEPT;
     friend DATE_API std::ostream& operator<<(std::ostream& os, const time_zone& z);
 
 #if !USE_OS_TZDB
     DATE_API void add(const std::string& s);
+    DATE_API void add(detail::line_reader in);
 #endif  // !USE_OS_TZDB
 
 private:
+    friend struct tzdb;
+#if !USE_OS_TZDB
+    friend struct detail::snapshot;
+    friend void detail::bind_rules(tzdb& db);
+    time_zone() = default;
+#endif  // !USE_OS_TZDB
+
     DATE_API sys_info   get_info_impl(sys_seconds tp) const;
     DATE_API local_info get_info_impl(local_seconds tp) const;
+#if HAS_STRING_VIEW
+    DATE_API sys_info_view   get_info_view_impl(sys_seconds tp) const;
+    DATE_API local_info_view get_info_view_impl(local_seconds tp) const;
+    // The period holding tp, and the one after i, or i itself if it is the last one.
+    // pos records where i was found, so that the next one can be found from there.
+    DATE_API sys_info_view first_info_view(sys_seconds tp, std::size_t& pos) const;
+    DATE_API sys_info_view next_info_view(const sys_info_view& i, std::size_t& pos) const;
+#endif
 
     template <class Duration>
         sys_time<typename std::common_type<Duration, std::chrono::seconds>::type>
@@ -838,20 +1044,56 @@ private:
         sys_time<typename std::common_type<Duration, std::chrono::seconds>::type>
         to_sys_impl(local_time<Duration> tp, choose, std::true_type) const;
 
+    DATE_API void get_offsets_impl(const sys_seconds* first, const sys_seconds* last,
+                                   std::chrono::seconds* result) const;
+    DATE_API void get_offsets_impl(const local_seconds* first, const local_seconds* last,
+                                   std::chrono::seconds* result) const;
+
+    template <class InputIterator, class OutputIterator, class F>
+        OutputIterator
+        sys_batch(InputIterator first, InputIterator last, OutputIterator result,
+                  F f) const;
+    template <class InputIterator, class OutputIterator, class F>
+        OutputIterator
+        local_batch(InputIterator first, InputIterator last, OutputIterator result,
+                    F f) const;
+
 #if USE_OS_TZDB
     DATE_API void init() const;
     DATE_API void init_impl();
+    DATE_API void build_index();
+    DATE_API std::vector<detail::transition>::const_iterator
+        find_transition(sys_seconds tp) const;
+    DATE_API std::vector<detail::transition>::const_iterator
+        find_transition(local_seconds tp) const;
     DATE_API sys_info
         load_sys_info(std::vector<detail::transition>::const_iterator i) const;
+    DATE_API sys_info load_footer_info(sys_seconds tp) const;
+#if HAS_STRING_VIEW
+    DATE_API sys_info_view
+        load_sys_info_view(std::vector<detail::transition>::const_iterator i) const;
+    DATE_API sys_info_view load_footer_info_view(sys_seconds tp) const;
+#endif
 
     template <class TimeType>
     DATE_API void
-    load_data(std::istream& inf, std::int32_t tzh_leapcnt, std::int32_t tzh_timecnt,
-                                 std::int32_t tzh_typecnt, std::int32_t tzh_charcnt);
+    load_data(const char* p, std::int32_t tzh_leapcnt, std::int32_t tzh_timecnt,
+                             std::int32_t tzh_typecnt, std::int32_t tzh_charcnt);
 #else  // !USE_OS_TZDB
     DATE_API sys_info   get_info_impl(sys_seconds tp, int timezone) const;
+    DATE_API sys_info   walk_rules(sys_seconds tp, int timezone,
+                                   const std::vector<detail::Rule>& rules) const;
+#if HAS_STRING_VIEW
+    DATE_API sys_info_view get_info_view_impl(sys_seconds tp, int timezone) const;
+    DATE_API std::string_view find_abbrev(const std::string& abbrev) const;
+#endif
+    DATE_API void init() const;
     DATE_API void adjust_infos(const std::vector<detail::Rule>& rules);
-    DATE_API void parse_info(std::istream& in);
+    DATE_API void compile_infos(const std::vector<detail::Rule>& rules);
+#if HAS_STRING_VIEW
+    DATE_API void collect_abbrevs(const std::vector<detail::Rule>& rules);
+#endif
+    DATE_API void parse_info(detail::line_reader& in);
 #endif  // !USE_OS_TZDB
 };
 
@@ -861,6 +1103,10 @@ inline
 time_zone::time_zone(time_zone&& src)
     : name_(std::move(src.name_))
     , zonelets_(std::move(src.zonelets_))
+    , compiled_(std::move(src.compiled_))
+    , rules_(src.rules_)
+    , snapshot_first_(src.snapshot_first_)
+    , snapshot_last_(src.snapshot_last_)
     , adjusted_(std::move(src.adjusted_))
     {}
 
@@ -870,6 +1116,10 @@ time_zone::operator=(time_zone&& src)
 {
     name_ = std::move(src.name_);
     zonelets_ = std::move(src.zonelets_);
+    compiled_ = std::move(src.compiled_);
+    rules_ = src.rules_;
+    snapshot_first_ = src.snapshot_first_;
+    snapshot_last_ = src.snapshot_last_;
     adjusted_ = std::move(src.adjusted_);
     return *this;
 }
@@ -883,6 +1133,13 @@ time_zone::name() const NOEXCEPT
     return name_;
 }
 
+inline
+bool
+time_zone::is_initialized() const NOEXCEPT
+{
+    return adjusted_->done.load(std::memory_order_acquire);
+}
+
 template <class Duration>
 inline
 sys_info
@@ -899,6 +1156,124 @@ time_zone::get_info(local_time<Duration> tp) const
     return get_info_impl(date::floor<std::chrono::seconds>(tp));
 }
 
+#if HAS_STRING_VIEW
+
+template <class Duration>
+inline
+sys_info_view
+time_zone::get_info_view(sys_time<Duration> st) const
+{
+    return get_info_view_impl(date::floor<std::chrono::seconds>(st));
+}
+
+template <class Duration>
+inline
+local_info_view
+time_zone::get_info_view(local_time<Duration> tp) const
+{
+    return get_info_view_impl(date::floor<std::chrono::seconds>(tp));
+}
+
+class time_zone::transition_iterator
+{
+    const time_zone* z_ = nullptr;  // nullptr at the end
+    sys_info_view    info_{};       // the period that t_ starts
+    std::size_t      pos_ = 0;
+    sys_seconds      to_{};
+    zone_transition  t_{};
+
+    // Periods begin no earlier than year::min()/January/1, and the last one ends at
+    // year::max()/December/31, so there are no transitions outside of those.
+    transition_iterator(const time_zone* z, sys_seconds from, sys_seconds to)
+        : z_(z)
+        , to_(std::min(to, sys_seconds{sys_days{year::max()/December/31}}))
+    {
+        auto const first = sys_seconds{sys_days{year::min()/January/1}};
+        info_ = z_->first_info_view(from > first ? from - std::chrono::seconds{1}
+                                                 : first, pos_);
+        ++*this;
+    }
+
+    friend class transition_range;
+
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type        = zone_transition;
+    using reference         = const value_type&;
+    using pointer           = const value_type*;
+    using difference_type   = std::ptrdiff_t;
+
+    transition_iterator() = default;
+
+    reference operator*() const NOEXCEPT {return t_;}
+    pointer  operator->() const NOEXCEPT {return &t_;}
+
+    transition_iterator&
+    operator++()
+    {
+        while (info_.end < to_)
+        {
+            auto next = z_->next_info_view(info_, pos_);
+            if (next.end <= info_.end)
+                break;
+            if (next.offset != info_.offset || next.save != info_.save ||
+                next.abbrev != info_.abbrev)
+            {
+                t_ = {next.begin, info_.offset, next.offset, next.save, next.abbrev};
+                info_ = next;
+                return *this;
+            }
+            info_ = next;
+        }
+        z_ = nullptr;
+        return *this;
+    }
+
+    transition_iterator operator++(int) {auto t = *this; ++(*this); return t;}
+
+    friend
+    bool
+    operator==(const transition_iterator& x, const transition_iterator& y) NOEXCEPT
+    {
+        return x.z_ == y.z_ && (x.z_ == nullptr || x.t_.when == y.t_.when);
+    }
+
+    friend
+    bool
+    operator!=(const transition_iterator& x, const transition_iterator& y) NOEXCEPT
+    {
+        return !(x == y);
+    }
+};
+
+class time_zone::transition_range
+{
+    const time_zone* z_;
+    sys_seconds      from_;
+    sys_seconds      to_;
+
+    transition_range(const time_zone* z, sys_seconds from, sys_seconds to) NOEXCEPT
+        : z_(z)
+        , from_(from)
+        , to_(to)
+        {}
+
+    friend class time_zone;
+
+public:
+    transition_iterator begin() const {return transition_iterator{z_, from_, to_};}
+    transition_iterator end() const NOEXCEPT {return transition_iterator{};}
+};
+
+inline
+time_zone::transition_range
+time_zone::transitions(sys_seconds from, sys_seconds to) const
+{
+    return transition_range{this, from, to};
+}
+
+#endif  // HAS_STRING_VIEW
+
 template <class Duration>
 inline
 sys_time<typename std::common_type<Duration, std::chrono::seconds>::type>
@@ -921,10 +1296,133 @@ local_time<typename std::common_type<Duration, std::chrono::seconds>::type>
 time_zone::to_local(sys_time<Duration> tp) const
 {
     using LT = local_time<typename std::common_type<Duration, std::chrono::seconds>::type>;
+    if (auto t = adjusted_->days.load(std::memory_order_acquire))
+    {
+        auto d = static_cast<std::size_t>((date::floor<days>(tp) - t->first).count());
+        if (d < t->entries.size() && (t->entries[d] & 1) == 0)
+            return LT{(tp + std::chrono::seconds{t->entries[d] / 2}).time_since_epoch()};
+    }
+#if HAS_STRING_VIEW
+    auto i = get_info_view(tp);
+#else
     auto i = get_info(tp);
+#endif
     return LT{(tp + i.offset).time_since_epoch()};
 }
 
+// The batches below are converted to seconds in chunks on the stack and handed to
+// get_offsets_impl, which remembers the last period it found and only searches
+// again when a time point falls outside of it.
+
+template <class InputIterator, class OutputIterator, class F>
+OutputIterator
+time_zone::sys_batch(InputIterator first, InputIterator last, OutputIterator result,
+                     F f) const
+{
+    using Duration = typename std::iterator_traits<InputIterator>::value_type::duration;
+    const std::size_t N = 256;
+    sys_time<Duration>   tp[N];
+    sys_seconds          tps[N];
+    std::chrono::seconds offset[N];
+    while (first != last)
+    {
+        std::size_t n = 0;
+        for (; n < N && first != last; ++first, ++n)
+        {
+            tp[n] = *first;
+            tps[n] = date::floor<std::chrono::seconds>(tp[n]);
+        }
+        get_offsets_impl(tps, tps + n, offset);
+        for (std::size_t k = 0; k < n; ++k, ++result)
+            *result = f(tp[k], offset[k]);
+    }
+    return result;
+}
+
+// get_offsets_impl marks a local time that isn't unique with seconds::min().  Those
+// are handed back to f to deal with one at a time.
+template <class InputIterator, class OutputIterator, class F>
+OutputIterator
+time_zone::local_batch(InputIterator first, InputIterator last, OutputIterator result,
+                       F f) const
+{
+    using Duration = typename std::iterator_traits<InputIterator>::value_type::duration;
+    const std::size_t N = 256;
+    local_time<Duration> tp[N];
+    local_seconds        tps[N];
+    std::chrono::seconds offset[N];
+    while (first != last)
+    {
+        std::size_t n = 0;
+        for (; n < N && first != last; ++first, ++n)
+        {
+            tp[n] = *first;
+            tps[n] = date::floor<std::chrono::seconds>(tp[n]);
+        }
+        get_offsets_impl(tps, tps + n, offset);
+        for (std::size_t k = 0; k < n; ++k, ++result)
+            *result = f(tp[k], offset[k]);
+    }
+    return result;
+}
+
+template <class InputIterator, class OutputIterator>
+OutputIterator
+time_zone::to_local(InputIterator first, InputIterator last, OutputIterator result) const
+{
+    using Duration = typename std::iterator_traits<InputIterator>::value_type::duration;
+    using LT = local_time<typename std::common_type<Duration, std::chrono::seconds>::type>;
+    return sys_batch(first, last, result,
+                     [](sys_time<Duration> tp, std::chrono::seconds offset)
+                     {
+                         return LT{(tp + offset).time_since_epoch()};
+                     });
+}
+
+template <class InputIterator, class OutputIterator>
+OutputIterator
+time_zone::to_sys(InputIterator first, InputIterator last, OutputIterator result) const
+{
+    using Duration = typename std::iterator_traits<InputIterator>::value_type::duration;
+    using ST = sys_time<typename std::common_type<Duration, std::chrono::seconds>::type>;
+    return local_batch(first, last, result,
+                       [this](local_time<Duration> tp, std::chrono::seconds offset) -> ST
+                       {
+                           if (offset == std::chrono::seconds::min())
+                               return to_sys(tp);
+                           return ST{(tp - offset).time_since_epoch()};
+                       });
+}
+
+template <class InputIterator, class OutputIterator>
+OutputIterator
+time_zone::to_sys(InputIterator first, InputIterator last, OutputIterator result,
+                  choose z) const
+{
+    using Duration = typename std::iterator_traits<InputIterator>::value_type::duration;
+    using ST = sys_time<typename std::common_type<Duration, std::chrono::seconds>::type>;
+    return local_batch(first, last, result,
+                       [this, z](local_time<Duration> tp, std::chrono::seconds offset) -> ST
+                       {
+                           if (offset == std::chrono::seconds::min())
+                               return to_sys(tp, z);
+                           return ST{(tp - offset).time_since_epoch()};
+                       });
+}
+
+template <class InputIterator, class OutputIterator>
+OutputIterator
+time_zone::get_offsets(InputIterator first, InputIterator last,
+                       OutputIterator result) const
+{
+    using Duration = typename std::iterator_traits<InputIterator>::value_type::duration;
+    return sys_batch(first, last, result,
+                     [](sys_time<Duration>, std::chrono::seconds offset)
+                     {
+                         return offset;
+                     });
+}
+
 inline bool operator==(const time_zone& x, const time_zone& y) NOEXCEPT {return x.name_ == y.name_;}
 inline bool operator< (const time_zone& x, const time_zone& y) NOEXCEPT {return x.name_ < y.name_;}
 
@@ -937,12 +1435,18 @@ template <class Duration>
 sys_time<typename std::common_type<Duration, std::chrono::seconds>::type>
 time_zone::to_sys_impl(local_time<Duration> tp, choose z, std::false_type) const
 {
+#if HAS_STRING_VIEW
+    auto i = get_info_view(tp);
+    using info = local_info_view;
+#else
     auto i = get_info(tp);
-    if (i.result == local_info::nonexistent)
+    using info = local_info;
+#endif
+    if (i.result == info::nonexistent)
     {
         return i.first.end;
     }
-    else if (i.result == local_info::ambiguous)
+    else if (i.result == info::ambiguous)
     {
         if (z == choose::latest)
             return sys_time<Duration>{tp.time_since_epoch()} - i.second.offset;
@@ -954,11 +1458,19 @@ template <class Duration>
 sys_time<typename std::common_type<Duration, std::chrono::seconds>::type>
 time_zone::to_sys_impl(local_time<Duration> tp, choose, std::true_type) const
 {
+#if HAS_STRING_VIEW
+    auto i = get_info_view(tp);
+    if (i.result == local_info_view::nonexistent)
+        throw nonexistent_local_time(tp, get_info(tp));
+    else if (i.result == local_info_view::ambiguous)
+        throw ambiguous_local_time(tp, get_info(tp));
+#else
     auto i = get_info(tp);
     if (i.result == local_info::nonexistent)
         throw nonexistent_local_time(tp, i);
     else if (i.result == local_info::ambiguous)
         throw ambiguous_local_time(tp, i);
+#endif
     return sys_time<Duration>{tp.time_since_epoch()} - i.first.offset;
 }
 
@@ -969,8 +1481,12 @@ class link
 private:
     std::string name_;
     std::string target_;
+
+    friend struct detail::snapshot;
+    link() = default;
 public:
     DATE_API explicit link(const std::string& s);
+    DATE_API explicit link(detail::line_reader in);
 
     const std::string& name() const {return name_;}
     const std::string& target() const {return target_;}
@@ -994,12 +1510,17 @@ class leap
 {
 private:
     sys_seconds date_;
+#if !USE_OS_TZDB
+    friend struct detail::snapshot;
+    leap() = default;
+#endif
 
 public:
 #if USE_OS_TZDB
     DATE_API explicit leap(const sys_seconds& s, detail::undocumented);
 #else
     DATE_API explicit leap(const std::string& s, detail::undocumented);
+    DATE_API explicit leap(detail::line_reader in, detail::undocumented);
 #endif
 
     sys_seconds date() const {return date_;}
@@ -1151,6 +1672,117 @@ struct timezone_mapping
 
 #endif  // _WIN32
 
+namespace detail
+{
+
+// One slot of tzdb::name_index: a zone or link name and the zone it resolves to.
+struct zone_index_entry
+{
+    std::uint32_t      hash;
+    const std::string* name;
+    const time_zone*   zone;
+};
+
+#if !MISSING_LEAP_SECONDS
+
+// tzdb::leap_index:  the dates of the leap seconds, with the count of leap seconds
+// before the start of each 2^shift second bucket from the first one.  count(tp) is the
+// number of leap seconds with a date at or before tp, the same as an upper_bound over
+// tzdb::leaps.  Times after the last leap second, which is nearly all of them, need
+// only one comparison.  Earlier ones need a bucket lookup and at most a step or two.
+struct leap_table
+{
+    static CONSTDATA unsigned shift = 23;  // about 97 days, less than between leaps
+
+    sys_seconds                first{};
+    sys_seconds                last{};
+    std::vector<sys_seconds>   dates;
+    std::vector<std::uint16_t> buckets;
+    sys_seconds                expires = sys_seconds::min();  // min() if not known
+
+    template <class Duration>
+    std::size_t
+    count(const sys_time<Duration>& tp) const
+    {
+        if (tp >= last)
+            return dates.size();
+        if (tp < first)
+            return 0;
+        auto b = static_cast<std::size_t>(
+                     (date::floor<std::chrono::seconds>(tp) - first).count() >> shift);
+        std::size_t i = buckets[b];
+        while (dates[i] <= tp)
+            ++i;
+        return i;
+    }
+};
+
+#endif  // !MISSING_LEAP_SECONDS
+
+}  // namespace detail
+
+// packed_zoned_time
+
+// A zoned timestamp in 8 bytes:  a count of Duration since the epoch, biased by 2^47,
+// in the high 48 bits and a tzdb zone id (see tzdb::zone_id) in the low 16.  It is
+// trivially copyable, so it can be stored in bulk or shared between processes, as
+// long as it is unpacked with a tzdb of the same version it was packed with.
+// Compared as unsigned integers, the bits order by time first.
+
+template <class Duration = std::chrono::seconds>
+class packed_zoned_time
+{
+    static CONSTDATA std::int64_t limit = std::int64_t{1} << 47;
+
+    std::uint64_t bits_ = static_cast<std::uint64_t>(limit) << 16;
+
+public:
+    using duration = Duration;
+
+    packed_zoned_time() = default;
+
+    packed_zoned_time(std::uint16_t zone_id, sys_time<Duration> tp)
+    {
+        auto c = static_cast<std::int64_t>(tp.time_since_epoch().count());
+        if (c < -limit || c >= limit)
+            throw std::runtime_error("packed_zoned_time: time point out of range");
+        bits_ = static_cast<std::uint64_t>(c + limit) << 16 | zone_id;
+    }
+
+    static
+    packed_zoned_time
+    from_bits(std::uint64_t bits) NOEXCEPT
+    {
+        packed_zoned_time p;
+        p.bits_ = bits;
+        return p;
+    }
+
+    std::uint64_t bits() const NOEXCEPT {return bits_;}
+
+    std::uint16_t zone_id() const NOEXCEPT {return static_cast<std::uint16_t>(bits_);}
+
+    sys_time<Duration>
+    get_sys_time() const NOEXCEPT
+    {
+        return sys_time<Duration>{Duration{static_cast<std::int64_t>(bits_ >> 16) - limit}};
+    }
+
+    friend
+    bool
+    operator==(const packed_zoned_time& x, const packed_zoned_time& y) NOEXCEPT
+    {
+        return x.bits_ == y.bits_;
+    }
+
+    friend
+    bool
+    operator!=(const packed_zoned_time& x, const packed_zoned_time& y) NOEXCEPT
+    {
+        return !(x == y);
+    }
+};
+
 struct tzdb
 {
     std::string               version = "unknown";
@@ -1163,13 +1795,30 @@ struct tzdb
 #endif
 #if !USE_OS_TZDB
     std::vector<detail::Rule> rules;
+    // The mapped snapshot file that the zones were loaded from, if any.  It stays
+    // mapped for as long as the zones might still decode themselves from it.
+    std::shared_ptr<const void> snapshot_data;
 #endif
 #ifdef _WIN32
     std::vector<detail::timezone_mapping> mappings;
 #endif
+    // Open addressed hash table over the names of zones and links, filled in when the
+    // database is loaded.  locate_zone falls back to searching zones and links if this
+    // is empty.
+    std::vector<detail::zone_index_entry> name_index;
+#if !MISSING_LEAP_SECONDS
+    // An index over leaps for utc_clock, filled in when the database is loaded.
+    detail::leap_table leap_index;
+#endif
+    // The day tables that materialize has built, by zone name.  A database that
+    // reload_tzdb or the tzdb watcher loads to replace this one builds them too.
+    mutable std::vector<detail::materialize_request> materialized;
+    // Set by tzdb_list when this is pushed, and changed afterwards only by
+    // erase_after and retire_after, which must not run concurrently with iteration.
     tzdb* next = nullptr;
 
     tzdb() = default;
+    ~tzdb();
 #if !defined(_MSC_VER) || (_MSC_VER >= 1900)
     tzdb(tzdb&&) = default;
     tzdb& operator=(tzdb&&) = default;
@@ -1180,7 +1829,11 @@ struct tzdb
         , links(std::move(src.links))
         , leaps(std::move(src.leaps))
         , rules(std::move(src.rules))
+        , snapshot_data(std::move(src.snapshot_data))
         , mappings(std::move(src.mappings))
+        , name_index(std::move(src.name_index))
+        , leap_index(std::move(src.leap_index))
+        , materialized(std::move(src.materialized))
     {}
 
     tzdb& operator=(tzdb&& src)
@@ -1190,7 +1843,11 @@ struct tzdb
         links = std::move(src.links);
         leaps = std::move(src.leaps);
         rules = std::move(src.rules);
+        snapshot_data = std::move(src.snapshot_data);
         mappings = std::move(src.mappings);
+        name_index = std::move(src.name_index);
+        leap_index = std::move(src.leap_index);
+        materialized = std::move(src.materialized);
         return *this;
     }
 #endif  // defined(_MSC_VER) && (_MSC_VER < 1900)
@@ -1201,18 +1858,114 @@ struct tzdb
     const time_zone* locate_zone(const std::string& tz_name) const;
 #endif
     const time_zone* current_zone() const;
-};
 
-using TZ_DB = tzdb;
+    // Zone ids number the zones of this database by their position in zones.  Throws
+    // std::runtime_error if z is not one of them, or if there is no zone id.
+    std::uint16_t    zone_id(const time_zone* z) const;
+    const time_zone* zone_from_id(std::uint16_t id) const;
 
-DATE_API std::ostream&
-operator<<(std::ostream& os, const tzdb& db);
+    template <class Duration>
+        packed_zoned_time<typename zoned_time<Duration>::duration>
+        pack(const zoned_time<Duration>& zt) const;
+    template <class Duration>
+        zoned_time<Duration>
+        unpack(packed_zoned_time<Duration> p) const;
+
+    // Builds a table of the named zone's UTC offset on each day of the years
+    // [first, last], so that its to_local(sys_time) is a single lookup except on
+    // days with a transition.  Replaces any table the zone had, or just removes it if
+    // first > last.  Returns the bytes used by the new table.  The request is kept in
+    // materialized, and the table built again in the database that reload_tzdb or the
+    // tzdb watcher loads to replace this one.  Though const, this changes the zone and
+    // this tzdb:  it is not safe to call while other threads are reading this tzdb, so
+    // call it before sharing the tzdb, as when setting up at startup.
+    std::size_t materialize(const std::string& name, year first, year last) const;
+    // The bytes used by the day tables of all of the zones.
+    std::size_t materialized_bytes() const;
+
+    // Initializes the named zones (or links) now rather than on their first use,
+    // spreading the work over up to threads threads.  threads == 0 means
+    // std::thread::hardware_concurrency().  Throws std::runtime_error, before doing
+    // any work, if a name is not found.
+    void prewarm(const std::vector<std::string>& names, unsigned threads = 0) const;
+    // As above, for every zone in the database.
+    void prewarm_all(unsigned threads = 0) const;
+};
+
+inline
+std::uint16_t
+tzdb::zone_id(const time_zone* z) const
+{
+    if (z == nullptr)
+        throw std::runtime_error("A null time_zone is not in this timezone database");
+    std::less<const time_zone*> less;
+    if (less(z, zones.data()) || !less(z, zones.data() + zones.size()))
+        throw std::runtime_error(z->name() + " is not in this timezone database");
+    auto i = static_cast<std::size_t>(z - zones.data());
+    if (i > 0xFFFF)
+        throw std::runtime_error(z->name() + " has no zone id");
+    return static_cast<std::uint16_t>(i);
+}
+
+inline
+const time_zone*
+tzdb::zone_from_id(std::uint16_t id) const
+{
+    if (id >= zones.size())
+        throw std::runtime_error("zone id " + std::to_string(id) +
+                                 " is not in this timezone database");
+    return &zones[id];
+}
+
+template <class Duration>
+inline
+packed_zoned_time<typename zoned_time<Duration>::duration>
+tzdb::pack(const zoned_time<Duration>& zt) const
+{
+    return {zone_id(zt.get_time_zone()), zt.get_sys_time()};
+}
+
+template <class Duration>
+inline
+zoned_time<Duration>
+tzdb::unpack(packed_zoned_time<Duration> p) const
+{
+    return {zone_from_id(p.zone_id()), p.get_sys_time()};
+}
+
+using TZ_DB = tzdb;
+
+DATE_API std::ostream&
+operator<<(std::ostream& os, const tzdb& db);
 
 DATE_API const tzdb& get_tzdb();
 
+#if USE_INFO_CACHE
+
+// Each thread remembers the last sys_info found for a handful of time_zones, and
+// answers get_info and get_info_view from it while the time point stays within
+// [begin, end).
+// These counters are for the calling thread only.
+struct info_cache_stats
+{
+    std::uint64_t hits;
+    std::uint64_t misses;
+};
+
+DATE_API info_cache_stats get_info_cache_stats();
+DATE_API void             reset_info_cache_stats();
+
+#endif  // USE_INFO_CACHE
+
 class tzdb_list
 {
     std::atomic<tzdb*> head_{nullptr};
+    // Databases unlinked by retire_after that reclaim has not yet freed, each with the
+    // epoch at which it was retired.
+    std::vector<std::pair<std::uint64_t, tzdb*>> retired_;
+    // Serializes push_front, erase_after, retire_after and reclaim, so that the list
+    // has one writer at a time.
+    std::mutex mut_;
 
 public:
     ~tzdb_list();
@@ -1232,6 +1985,18 @@ public:
 
     const_iterator erase_after(const_iterator p) noexcept;
 
+    // Safe reclamation of old databases.  A reader that holds a pin can keep using
+    // anything it reaches from front() (tzdbs, time_zones, leaps) until the pin is
+    // destroyed.  retire_after unlinks the database after p like erase_after, but
+    // defers deleting it until reclaim finds that every pin which might still refer
+    // to it is gone.  reclaim returns the number of retired databases still waiting
+    // to be freed.  Like erase_after, retire_after must not run concurrently with
+    // iteration over the list.
+    class pin;
+
+    const_iterator retire_after(const_iterator p);
+    std::size_t reclaim();
+
     struct undocumented_helper;
 private:
     void push_front(tzdb* tzdb) noexcept;
@@ -1270,6 +2035,18 @@ public:
     friend class tzdb_list;
 };
 
+// Pinning costs a load and a store to a slot owned by the calling thread; it takes no
+// lock.  Pins may be nested.
+class tzdb_list::pin
+{
+public:
+    pin();
+    ~pin();
+
+    pin(const pin&) = delete;
+    pin& operator=(const pin&) = delete;
+};
+
 inline
 tzdb_list::const_iterator
 tzdb_list::begin() const noexcept
@@ -1300,6 +2077,49 @@ tzdb_list::cend() const noexcept
 
 DATE_API tzdb_list& get_tzdb_list();
 
+#if !MISSING_LEAP_SECONDS
+
+// Reads a leap-seconds.list file, in the format published by the IERS and NIST and
+// shipped with tzdata, and makes its leap seconds the ones used by utc_clock (and so
+// by tai_clock, gps_clock and clock_cast) without reloading the rest of the database.
+// tzdb::leaps is not changed.  The new table is published atomically, so conversions
+// running at the same time never wait for it.  Returns the date the list expires.
+// A list that is older than the leap seconds in use, one that stops at an earlier
+// leap second or ends with the same one and expires sooner, is ignored, and the
+// expiration of those in use is returned.  Throws std::runtime_error if the file
+// can't be read or isn't a valid list.  Loading a new tzdb, as reload_tzdb and the
+// watcher do, keeps these leap seconds if they are newer than those of the new
+// database:  if they go past its last leap second, or end with the same one and have
+// an expiration date.  Otherwise it goes back to the leap seconds of that database.
+DATE_API sys_seconds reload_leap_seconds(const std::string& path);
+// As above, from leap-seconds.list in the folder the database is loaded from.
+DATE_API sys_seconds reload_leap_seconds();
+// The date the leap seconds in use expire, or sys_seconds::min() if that isn't known.
+DATE_API sys_seconds leap_seconds_expiration();
+
+namespace detail
+{
+
+// The leap seconds in use:  those of the database last pushed onto get_tzdb_list(),
+// or the ones loaded by reload_leap_seconds if those are newer.  Null until the
+// database is first loaded.
+extern DATE_API std::atomic<const leap_table*> published_leaps;
+
+DATE_API const leap_table& load_current_leaps();
+
+inline
+const leap_table&
+current_leaps()
+{
+    if (auto t = published_leaps.load(std::memory_order_acquire))
+        return *t;
+    return load_current_leaps();
+}
+
+}  // namespace detail
+
+#endif  // !MISSING_LEAP_SECONDS
+
 #if !USE_OS_TZDB
 
 DATE_API const tzdb& reload_tzdb();
@@ -1307,6 +2127,24 @@ DATE_API void        set_install(const std::string& install);
 
 #endif  // !USE_OS_TZDB
 
+#if USE_TZDB_WATCHER
+
+// Starts a thread that watches the folder the database is loaded from (the install
+// folder, or the OS zoneinfo folder with USE_OS_TZDB) for changes.  Once the folder
+// has been quiet for settle, the thread loads a new tzdb and publishes it at the
+// front of get_tzdb_list().  Readers never wait for it.  As with reload_tzdb, the
+// databases it replaces stay in the list, so zones and leaps from them remain valid.
+// An application that wants them freed can retire_after and reclaim them itself, at
+// a time when nothing iterates over the list.  If the new database fails to load,
+// the current one stays in place.  Leap seconds loaded by reload_leap_seconds stay in
+// use across these reloads while they are newer than those of the new database.  Does
+// nothing if the watcher is already running.
+DATE_API void start_tzdb_watcher(std::chrono::milliseconds settle = std::chrono::seconds{1});
+// Stops the watcher thread and waits for it to finish.
+DATE_API void stop_tzdb_watcher();
+
+#endif  // USE_TZDB_WATCHER
+
 #if HAS_REMOTE_API
 
 DATE_API std::string remote_version();
@@ -1820,11 +2658,39 @@ to_stream(std::basic_ostream<CharT, Traits>& os, const CharT* fmt,
     using duration = typename zoned_time<Duration, TimeZonePtr>::duration;
     using LT = local_time<duration>;
     auto const st = tp.get_sys_time();
-    auto const info = tp.get_time_zone()->get_info(st);
+    auto const info = tp.get_info();
     return to_stream(os, fmt, LT{(st+info.offset).time_since_epoch()},
                      &info.abbrev, &info.offset);
 }
 
+template <class CharT, class Traits, class Duration, class TimeZonePtr>
+std::basic_ostream<CharT, Traits>&
+to_stream(std::basic_ostream<CharT, Traits>& os, const compiled_format<CharT, Traits>& fmt,
+          const zoned_time<Duration, TimeZonePtr>& tp)
+{
+    using duration = typename zoned_time<Duration, TimeZonePtr>::duration;
+    using LT = local_time<duration>;
+    auto const st = tp.get_sys_time();
+    auto const info = tp.get_info();
+    return to_stream(os, fmt, LT{(st+info.offset).time_since_epoch()},
+                     &info.abbrev, &info.offset);
+}
+
+template <class OutputIt, class Format, class Duration, class TimeZonePtr>
+auto
+format_to(OutputIt out, const Format& fmt, const zoned_time<Duration, TimeZonePtr>& tp)
+    -> decltype(detail::fields_to(out, fmt,
+                    fields<typename zoned_time<Duration, TimeZonePtr>::duration>{},
+                    nullptr, nullptr))
+{
+    using duration = typename zoned_time<Duration, TimeZonePtr>::duration;
+    auto const info = tp.get_info();
+    auto const lt = local_time<duration>{(tp.get_sys_time()+info.offset).time_since_epoch()};
+    auto ld = floor<days>(lt);
+    fields<duration> fds{year_month_day{ld}, hh_mm_ss<duration>{lt-local_seconds{ld}}};
+    return detail::fields_to(out, fmt, fds, &info.abbrev, &info.offset);
+}
+
 template <class CharT, class Traits, class Duration, class TimeZonePtr>
 inline
 std::basic_ostream<CharT, Traits>&
@@ -1834,6 +2700,282 @@ operator<<(std::basic_ostream<CharT, Traits>& os, const zoned_time<Duration, Tim
     return to_stream(os, fmt, t);
 }
 
+// caching_zone
+
+// A TimeZonePtr for zoned_time which remembers the last sys_info its zone returned,
+// and answers from it while the time asked about stays within [begin, end).  So
+// zoned_time<Duration, caching_zone<>> only consults the time_zone when it moves into
+// another offset period.  The cache is updated by const member functions without any
+// synchronization, so one caching_zone (or a zoned_time holding one) must not be
+// used from several threads at once.
+
+template <class TimeZonePtr = const time_zone*>
+class caching_zone
+{
+    TimeZonePtr      zone_;
+    mutable sys_info info_{};
+
+public:
+    caching_zone(TimeZonePtr z)
+        : zone_(std::move(z))
+        {}
+
+    const TimeZonePtr& get() const NOEXCEPT {return zone_;}
+    const caching_zone* operator->() const NOEXCEPT {return this;}
+
+    const std::string& name() const {return zone_->name();}
+
+    template <class Duration>
+        sys_info
+        get_info(sys_time<Duration> tp) const
+        {
+            return find(date::floor<std::chrono::seconds>(tp));
+        }
+
+    template <class Duration>
+        local_info
+        get_info(local_time<Duration> tp) const
+        {
+            auto lt = date::floor<std::chrono::seconds>(tp);
+            if (is_unique(lt))
+                return {local_info::unique, info_, sys_info{}};
+            auto r = zone_->get_info(lt);
+            if (r.result == local_info::unique)
+                info_ = r.first;
+            return r;
+        }
+
+    template <class Duration>
+        local_time<typename std::common_type<Duration, std::chrono::seconds>::type>
+        to_local(sys_time<Duration> tp) const
+        {
+            using LT = local_time<typename std::common_type<Duration,
+                                                            std::chrono::seconds>::type>;
+            return LT{(tp + find(date::floor<std::chrono::seconds>(tp)).offset)
+                         .time_since_epoch()};
+        }
+
+    template <class Duration>
+        sys_time<typename std::common_type<Duration, std::chrono::seconds>::type>
+        to_sys(local_time<Duration> tp) const
+        {
+            using ST = sys_time<typename std::common_type<Duration,
+                                                          std::chrono::seconds>::type>;
+            if (get_info(tp).result == local_info::unique)
+                return ST{(tp - info_.offset).time_since_epoch()};
+            return zone_->to_sys(tp);
+        }
+
+    template <class Duration>
+        sys_time<typename std::common_type<Duration, std::chrono::seconds>::type>
+        to_sys(local_time<Duration> tp, choose z) const
+        {
+            using ST = sys_time<typename std::common_type<Duration,
+                                                          std::chrono::seconds>::type>;
+            if (get_info(tp).result == local_info::unique)
+                return ST{(tp - info_.offset).time_since_epoch()};
+            return zone_->to_sys(tp, z);
+        }
+
+    friend
+    bool
+    operator==(const caching_zone& x, const caching_zone& y) NOEXCEPT
+    {
+        return x.zone_ == y.zone_;
+    }
+
+    friend
+    bool
+    operator!=(const caching_zone& x, const caching_zone& y) NOEXCEPT
+    {
+        return !(x == y);
+    }
+
+private:
+    const sys_info&
+    find(sys_seconds tp) const
+    {
+        if (!(info_.begin <= tp && tp < info_.end))
+            info_ = zone_->get_info(tp);
+        return info_;
+    }
+
+    // A local time at least a day away from both ends of the cached period can't be
+    // ambiguous or nonexistent.
+    bool
+    is_unique(local_seconds tp) const
+    {
+        auto st = sys_seconds{(tp - info_.offset).time_since_epoch()};
+        return info_.begin + days{1} <= st && st < info_.end - days{1};
+    }
+};
+
+template <class TimeZonePtr>
+struct zoned_traits<caching_zone<TimeZonePtr>>
+{
+    static
+    auto
+    default_zone()
+        -> decltype(caching_zone<TimeZonePtr>(zoned_traits<TimeZonePtr>::default_zone()))
+    {
+        return caching_zone<TimeZonePtr>(zoned_traits<TimeZonePtr>::default_zone());
+    }
+
+#if HAS_STRING_VIEW
+
+    static
+    auto
+    locate_zone(std::string_view name)
+        -> decltype(caching_zone<TimeZonePtr>(zoned_traits<TimeZonePtr>::locate_zone(name)))
+    {
+        return caching_zone<TimeZonePtr>(zoned_traits<TimeZonePtr>::locate_zone(name));
+    }
+
+#else  // !HAS_STRING_VIEW
+
+    static
+    auto
+    locate_zone(const std::string& name)
+        -> decltype(caching_zone<TimeZonePtr>(zoned_traits<TimeZonePtr>::locate_zone(name)))
+    {
+        return caching_zone<TimeZonePtr>(zoned_traits<TimeZonePtr>::locate_zone(name));
+    }
+
+    static
+    auto
+    locate_zone(const char* name)
+        -> decltype(caching_zone<TimeZonePtr>(zoned_traits<TimeZonePtr>::locate_zone(name)))
+    {
+        return caching_zone<TimeZonePtr>(zoned_traits<TimeZonePtr>::locate_zone(name));
+    }
+
+#endif  // !HAS_STRING_VIEW
+};
+
+// fixed_offset_zone
+
+namespace detail
+{
+
+// The sys_info of a zone that is always offset from UTC.  The abbreviation is
+// written as tzdata writes numeric ones ("+05", "+0530").  Offsets that are a
+// multiple of 15 minutes within 14 hours of UTC are built once and copied after that.
+DATE_API sys_info fixed_offset_info(std::chrono::minutes offset);
+
+// Parses a UTC offset written as "Z", "+HH", "+HHMM" or "+HH:MM" (or with '-'), and
+// throws std::runtime_error if that isn't what [p, p+n) holds.
+DATE_API std::chrono::minutes parse_utc_offset(const char* p, std::size_t n);
+
+}  // namespace detail
+
+// A TimeZonePtr for zoned_time which is always offset from UTC by the same amount.
+// It is held by value, and converting between sys_time and local_time is a single
+// addition, so it suits timestamps that carry their own offset (e.g. parsed with %z).
+
+class fixed_offset_zone
+{
+    std::chrono::minutes offset_;
+
+public:
+    CONSTCD11 explicit fixed_offset_zone(std::chrono::minutes offset) NOEXCEPT
+        : offset_(offset)
+        {}
+
+    CONSTCD11 std::chrono::minutes offset() const NOEXCEPT {return offset_;}
+
+    template <class Duration>
+        CONSTCD14
+        local_time<typename std::common_type<Duration, std::chrono::minutes>::type>
+        to_local(sys_time<Duration> tp) const NOEXCEPT
+        {
+            using LT = local_time<typename std::common_type<Duration,
+                                                            std::chrono::minutes>::type>;
+            return LT{tp.time_since_epoch() + offset_};
+        }
+
+    template <class Duration>
+        CONSTCD14
+        sys_time<typename std::common_type<Duration, std::chrono::minutes>::type>
+        to_sys(local_time<Duration> tp, choose = choose::earliest) const NOEXCEPT
+        {
+            using ST = sys_time<typename std::common_type<Duration,
+                                                          std::chrono::minutes>::type>;
+            return ST{tp.time_since_epoch() - offset_};
+        }
+
+    template <class Duration>
+        sys_info
+        get_info(sys_time<Duration>) const
+        {
+            return detail::fixed_offset_info(offset_);
+        }
+
+    template <class Duration>
+        local_info
+        get_info(local_time<Duration>) const
+        {
+            return {local_info::unique, detail::fixed_offset_info(offset_), sys_info{}};
+        }
+
+    CONSTCD14 const fixed_offset_zone* operator->() const NOEXCEPT {return this;}
+
+    friend
+    CONSTCD11
+    bool
+    operator==(const fixed_offset_zone& x, const fixed_offset_zone& y) NOEXCEPT
+    {
+        return x.offset_ == y.offset_;
+    }
+
+    friend
+    CONSTCD11
+    bool
+    operator!=(const fixed_offset_zone& x, const fixed_offset_zone& y) NOEXCEPT
+    {
+        return !(x == y);
+    }
+};
+
+// Naming a fixed_offset_zone means writing its offset, e.g.
+// zoned_time<std::chrono::seconds, fixed_offset_zone>{"+05:30", tp}.
+template <>
+struct zoned_traits<fixed_offset_zone>
+{
+    static
+    fixed_offset_zone
+    default_zone()
+    {
+        return fixed_offset_zone{std::chrono::minutes{0}};
+    }
+
+#if HAS_STRING_VIEW
+
+    static
+    fixed_offset_zone
+    locate_zone(std::string_view name)
+    {
+        return fixed_offset_zone{detail::parse_utc_offset(name.data(), name.size())};
+    }
+
+#else  // !HAS_STRING_VIEW
+
+    static
+    fixed_offset_zone
+    locate_zone(const std::string& name)
+    {
+        return fixed_offset_zone{detail::parse_utc_offset(name.data(), name.size())};
+    }
+
+    static
+    fixed_offset_zone
+    locate_zone(const char* name)
+    {
+        return fixed_offset_zone{detail::parse_utc_offset(name, std::strlen(name))};
+    }
+
+#endif  // !HAS_STRING_VIEW
+};
+
 #if !MISSING_LEAP_SECONDS
 
 class utc_clock
@@ -1879,9 +3021,8 @@ utc_clock::from_sys(const sys_time<Duration>& st)
 {
     using std::chrono::seconds;
     using CD = typename std::common_type<Duration, seconds>::type;
-    auto const& leaps = get_tzdb().leaps;
-    auto const lt = std::upper_bound(leaps.begin(), leaps.end(), st);
-    return utc_time<CD>{st.time_since_epoch() + seconds{lt-leaps.begin()}};
+    auto const n = detail::current_leaps().count(st);
+    return utc_time<CD>{st.time_since_epoch() + seconds{static_cast<seconds::rep>(n)}};
 }
 
 // Return pair<is_leap_second, seconds{number_of_leap_seconds_since_1970}>
@@ -1893,17 +3034,18 @@ is_leap_second(date::utc_time<Duration> const& ut)
 {
     using std::chrono::seconds;
     using duration = typename std::common_type<Duration, seconds>::type;
-    auto const& leaps = get_tzdb().leaps;
+    auto const& leaps = detail::current_leaps();
     auto tp = sys_time<duration>{ut.time_since_epoch()};
-    auto const lt = std::upper_bound(leaps.begin(), leaps.end(), tp);
-    auto ds = seconds{lt-leaps.begin()};
+    auto const n = leaps.count(tp);
+    auto ds = seconds{static_cast<seconds::rep>(n)};
     tp -= ds;
     auto ls = false;
-    if (lt > leaps.begin())
+    if (n > 0)
     {
-        if (tp < lt[-1])
+        auto const last = leaps.dates[n-1];
+        if (tp < last)
         {
-            if (tp >= lt[-1].date() - seconds{1})
+            if (tp >= last - seconds{1})
                 ls = true;
             else
                 --ds;
@@ -2654,6 +3796,192 @@ clock_cast(const std::chrono::time_point<SrcClock, Duration>& tp)
     return clock_cast_detail::cc_impl<DstClock>(tp, &tp);
 }
 
+// Batch clock_cast
+
+namespace clock_cast_detail
+{
+
+// Converts between sys_time and utc_time for a run of time points, remembering the
+// span of time over which the last leap second count holds.  Time points in the same
+// span as the last one, which is nearly all of them when the input is sorted, need
+// only two comparisons and no search of the leap seconds.  The spans before the first
+// and after the last leap second are open ended, rather than bounded by min() and
+// max(), which would overflow when compared with finer durations.
+class leap_cursor
+{
+    using seconds = std::chrono::seconds;
+
+    const detail::leap_table* t_ = nullptr;
+    sys_seconds lo_{};
+    sys_seconds hi_{};
+    utc_seconds ulo_{};
+    utc_seconds uhi_{};
+    seconds n_{0};
+    bool has_lo_ = true;
+    bool has_hi_ = true;
+
+    const detail::leap_table&
+    leaps()
+    {
+        if (t_ == nullptr)
+            t_ = &detail::current_leaps();
+        return *t_;
+    }
+
+    void
+    set(std::size_t n)
+    {
+        auto const& d = t_->dates;
+        n_ = seconds{static_cast<seconds::rep>(n)};
+        has_lo_ = n > 0;
+        has_hi_ = n < d.size();
+        if (has_lo_)
+        {
+            lo_ = d[n-1];
+            ulo_ = utc_seconds{d[n-1].time_since_epoch() + n_};
+        }
+        if (has_hi_)
+        {
+            hi_ = d[n];
+            uhi_ = utc_seconds{d[n].time_since_epoch() + n_};
+        }
+    }
+
+    template <class Duration>
+    bool
+    in_span(const sys_time<Duration>& st) const
+    {
+        return (!has_lo_ || lo_ <= st) && (!has_hi_ || st < hi_);
+    }
+
+    template <class Duration>
+    bool
+    in_span(const utc_time<Duration>& ut) const
+    {
+        return (!has_lo_ || ulo_ <= ut) && (!has_hi_ || ut < uhi_);
+    }
+
+public:
+    template <class Duration>
+    utc_time<typename std::common_type<Duration, std::chrono::seconds>::type>
+    from_sys(const sys_time<Duration>& st)
+    {
+        using CD = typename std::common_type<Duration, seconds>::type;
+        if (!in_span(st))
+            set(leaps().count(st));
+        return utc_time<CD>{st.time_since_epoch() + n_};
+    }
+
+    // Time points during a leap second are outside every span, and are left to
+    // utc_clock::to_sys.
+    template <class Duration>
+    sys_time<typename std::common_type<Duration, std::chrono::seconds>::type>
+    to_sys(const utc_time<Duration>& ut)
+    {
+        using CD = typename std::common_type<Duration, seconds>::type;
+        if (!in_span(ut))
+        {
+            auto st = utc_clock::to_sys(ut);
+            set(leaps().count(st));
+            if (!in_span(ut))
+                return st;
+        }
+        return sys_time<CD>{ut.time_since_epoch() - n_};
+    }
+};
+
+template <class DstClock, class SrcClock, class Duration>
+auto
+conv_clock(const time_point<SrcClock, Duration>& t, leap_cursor&)
+    -> decltype(conv_clock<DstClock>(t))
+{
+    return conv_clock<DstClock>(t);
+}
+
+template <class DstClock, class Duration>
+auto
+conv_clock(const sys_time<Duration>& t, leap_cursor& c)
+    -> typename std::enable_if<std::is_same<DstClock, utc_clock>::value,
+                               decltype(c.from_sys(t))>::type
+{
+    return c.from_sys(t);
+}
+
+template <class DstClock, class Duration>
+auto
+conv_clock(const utc_time<Duration>& t, leap_cursor& c)
+    -> typename std::enable_if<std::is_same<DstClock, system_clock>::value,
+                               decltype(c.to_sys(t))>::type
+{
+    return c.to_sys(t);
+}
+
+// The candidates of cc_impl, with the sys <-> utc step going through the cursor
+
+template <class DstClock, class SrcClock, class Duration>
+auto
+bc_impl(const time_point<SrcClock, Duration>& t, leap_cursor& c,
+        const time_point<SrcClock, Duration>*)
+    -> decltype(conv_clock<DstClock>(t))
+{
+    return conv_clock<DstClock>(t, c);
+}
+
+template <class DstClock, class SrcClock, class Duration>
+auto
+bc_impl(const time_point<SrcClock, Duration>& t, leap_cursor& c, const void*)
+    -> decltype(conv_clock<DstClock>(conv_clock<system_clock>(t)))
+{
+    return conv_clock<DstClock>(conv_clock<system_clock>(t, c), c);
+}
+
+template <class DstClock, class SrcClock, class Duration>
+auto
+bc_impl(const time_point<SrcClock, Duration>& t, leap_cursor& c, const void*)
+    -> decltype(0,  // MSVC_WORKAROUND
+                conv_clock<DstClock>(conv_clock<utc_clock>(t)))
+{
+    return conv_clock<DstClock>(conv_clock<utc_clock>(t, c), c);
+}
+
+template <class DstClock, class SrcClock, class Duration>
+auto
+bc_impl(const time_point<SrcClock, Duration>& t, leap_cursor& c, ...)
+    -> decltype(conv_clock<DstClock>(conv_clock<utc_clock>(conv_clock<system_clock>(t))))
+{
+    return conv_clock<DstClock>(conv_clock<utc_clock>(conv_clock<system_clock>(t, c), c), c);
+}
+
+template <class DstClock, class SrcClock, class Duration>
+auto
+bc_impl(const time_point<SrcClock, Duration>& t, leap_cursor& c, ...)
+    -> decltype(0,  // MSVC_WORKAROUND
+                conv_clock<DstClock>(conv_clock<system_clock>(conv_clock<utc_clock>(t))))
+{
+    return conv_clock<DstClock>(conv_clock<system_clock>(conv_clock<utc_clock>(t, c), c), c);
+}
+
+}  // namespace clock_cast_detail
+
+// Converts [first, last) to DstClock as clock_cast does, storing the results through
+// result, and returns the end of the output.  Each conversion between sys_time and
+// utc_time reuses the leap second count of the one before when it still applies, so
+// sorted input, or input that rarely crosses a leap second, is converted without
+// searching the leap seconds.  User clocks are converted through their to_sys /
+// from_sys or to_utc / from_utc as with clock_cast.
+template <class DstClock, class InputIterator, class OutputIterator>
+OutputIterator
+clock_cast(InputIterator first, InputIterator last, OutputIterator result)
+{
+    clock_cast_detail::leap_cursor c;
+    for (; first != last; ++first, (void)++result)
+    {
+        auto const& tp = *first;
+        *result = clock_cast_detail::bc_impl<DstClock>(tp, c, &tp);
+    }
+    return result;
+}
+
 // Deprecated API
 
 template <class Duration>
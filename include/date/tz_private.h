@@ -40,13 +40,55 @@ namespace date
 namespace detail
 {
 
+// A cursor over one line of tzdata text.  It reads the line in place with the
+// same rules as the formatted extractors of an istream, and throws
+// std::runtime_error where an istream with exceptions enabled would.
+class line_reader
+{
+private:
+    const char* first_;
+    const char* p_;
+    const char* last_;
+
+public:
+    line_reader(const char* first, const char* last)
+        : first_(first)
+        , p_(first)
+        , last_(last)
+        {}
+
+    explicit line_reader(const std::string& s)
+        : line_reader(s.data(), s.data() + s.size())
+        {}
+
+    bool eof() const {return p_ == last_;}
+    int peek() const
+    {
+        return p_ == last_ ? std::char_traits<char>::eof()
+                           : std::char_traits<char>::to_int_type(*p_);
+    }
+    std::string str() const {return std::string(first_, last_);}
+
+    void ws();
+    char get();
+    char read_char();
+    int read_int();
+    std::string read_word();
+};
+
 #if !USE_OS_TZDB
 
 enum class tz {utc, local, standard};
 
+struct snapshot;
+
+// Waits until the snapshot that a load started writing, if any, has been written.
+// Defined only with TZDB_SNAPSHOT=1.
+void wait_for_snapshot();
+
 //forward declare to avoid warnings in gcc 6.2
 class MonthDayTime;
-std::istream& operator>>(std::istream& is, MonthDayTime& x);
+line_reader& operator>>(line_reader& is, MonthDayTime& x);
 std::ostream& operator<<(std::ostream& os, const MonthDayTime& x);
 
 
@@ -119,8 +161,9 @@ public:
     int compare(date::year y, const MonthDayTime& x, date::year yx,
                 std::chrono::seconds offset, std::chrono::minutes prev_save) const;
 
-    friend std::istream& operator>>(std::istream& is, MonthDayTime& x);
+    friend line_reader& operator>>(line_reader& is, MonthDayTime& x);
     friend std::ostream& operator<<(std::ostream& os, const MonthDayTime& x);
+    friend struct snapshot;
 };
 
 // A Rule specifies one or more set of datetimes without using an offset.
@@ -158,6 +201,7 @@ private:
 public:
     Rule() = default;
     explicit Rule(const std::string& s);
+    explicit Rule(line_reader in);
     Rule(const Rule& r, date::year starting_year, date::year ending_year);
 
     const std::string& name() const {return name_;}
@@ -182,6 +226,7 @@ public:
     friend bool operator<(const std::string& x, const Rule& y);
 
     friend std::ostream& operator<<(std::ostream& os, const Rule& r);
+    friend struct snapshot;
 
 private:
     date::day day() const;
@@ -258,16 +303,6 @@ struct zonelet
 
 #else  // USE_OS_TZDB
 
-struct ttinfo
-{
-    std::int32_t  tt_gmtoff;
-    unsigned char tt_isdst;
-    unsigned char tt_abbrind;
-    unsigned char pad[2];
-};
-
-static_assert(sizeof(ttinfo) == 8, "");
-
 struct expanded_ttinfo
 {
     std::chrono::seconds offset;
@@ -92,13 +92,20 @@
 #endif
 
 #if USE_OS_TZDB
+#  include "date/ptz.h"
 #  include <dirent.h>
 #endif
 #include <algorithm>
 #include <cctype>
+#include <cstdint>
+#include <cstdio>
 #include <cstdlib>
 #include <cstring>
 #include <cwchar>
+#if USE_OS_TZDB && USE_TZDATA_ZI
+#  include <deque>
+#  include <map>
+#endif
 #include <exception>
 #include <fstream>
 #include <iostream>
@@ -109,6 +116,7 @@
 #endif
 #include <sstream>
 #include <string>
+#include <thread>
 #include <tuple>
 #include <vector>
 #include <sys/stat.h>
@@ -139,10 +147,16 @@
 #    include <shellapi.h> // ShFileOperation etc.
 #  endif  // HAS_REMOTE_API
 #else   // !_WIN32
+#  include <fcntl.h>
 #  include <unistd.h>
 #  if !USE_OS_TZDB
+#    include <sys/mman.h>
 #    include <wordexp.h>
 #  endif
+#  if USE_TZDB_WATCHER
+#    include <poll.h>
+#    include <sys/inotify.h>
+#  endif
 #  include <limits.h>
 #  include <string.h>
 #  if !USE_SHELL_API
@@ -338,7 +352,51 @@ CONSTDATA auto max_day = date::December/31;
 
 CONSTCD14 const sys_seconds min_seconds = sys_days(min_year/min_day);
 
-#endif  // USE_OS_TZDB
+// With USE_TZDATA_ZI=1 the zone names are read from the tzdata.zi file in the zoneinfo
+// directory, instead of by walking the directory and stat'ing every file in it.  Zone
+// files that tzdata.zi doesn't name are still found by locate_zone, when it is asked
+// for them.  If there is no tzdata.zi, the directory is walked.
+#ifndef USE_TZDATA_ZI
+#  define USE_TZDATA_ZI 0
+#endif
+
+#else  // !USE_OS_TZDB
+
+// The first time a time_zone is used, the sys_info's in effect for the years
+// [COMPILED_FIRST_YEAR, COMPILED_LAST_YEAR] are computed from the zonelets and rules
+// and stored in a table, so that get_info within this range is a single binary search.
+// Outside of this range the rules are walked on every call.  Setting
+// COMPILED_FIRST_YEAR > COMPILED_LAST_YEAR turns the table off.
+#ifndef COMPILED_FIRST_YEAR
+#  define COMPILED_FIRST_YEAR 1970
+#endif
+#ifndef COMPILED_LAST_YEAR
+#  define COMPILED_LAST_YEAR 2037
+#endif
+
+CONSTDATA auto compiled_first_year = date::year{COMPILED_FIRST_YEAR};
+CONSTDATA auto compiled_last_year = date::year{COMPILED_LAST_YEAR};
+
+// With PARALLEL_TZDB_LOAD=1 the tzdata region files are parsed concurrently on up to
+// std::thread::hardware_concurrency() threads, and the results are merged in file
+// order, so the database is the same as when they are parsed one after another.
+#ifndef PARALLEL_TZDB_LOAD
+#  define PARALLEL_TZDB_LOAD 0
+#endif
+
+// With TZDB_SNAPSHOT=1 the parsed database, with every zone adjusted to its rules and
+// compiled, is saved to a snapshot file in the user's cache folder ($XDG_CACHE_HOME/date,
+// ~/.cache/date, or %LOCALAPPDATA%\date), named for the install folder.  Later loads
+// map that file instead of parsing the text, as long as the tzdata files have not
+// changed since it was written.  Each time_zone decodes its own data from the mapping
+// when it is first used, instead of adjusting and compiling it.  A load that parses the
+// text starts writing the snapshot on a thread of its own, and returns without waiting
+// for it.  A process that exits before the write is done waits for it then.
+#ifndef TZDB_SNAPSHOT
+#  define TZDB_SNAPSHOT 0
+#endif
+
+#endif  // !USE_OS_TZDB
 
 #ifndef _WIN32
 
@@ -402,6 +460,330 @@ static_assert(min_year <= max_year, "Configuration error");
 #endif
 
 static std::unique_ptr<tzdb> init_tzdb();
+static void rematerialize(const tzdb& db, const tzdb& old);
+#if USE_OS_TZDB && USE_TZDATA_ZI
+static void forget_unlisted_zones(const tzdb* db);
+#endif
+
+// FNV-1a
+static
+std::uint32_t
+name_hash(const char* p, std::size_t n)
+{
+    std::uint32_t h = 2166136261u;
+    for (; n > 0; --n, ++p)
+    {
+        h ^= static_cast<unsigned char>(*p);
+        h *= 16777619u;
+    }
+    return h;
+}
+
+static
+const time_zone*
+find_in_name_index(const tzdb& db, const char* p, std::size_t n)
+{
+    auto h = name_hash(p, n);
+    auto mask = db.name_index.size() - 1;
+    for (auto i = h & mask;; i = (i + 1) & mask)
+    {
+        auto const& e = db.name_index[i];
+        if (e.name == nullptr)
+            return nullptr;
+        if (e.hash == h && e.name->size() == n && std::memcmp(e.name->data(), p, n) == 0)
+            return e.zone;
+    }
+}
+
+// Keeps the table at most half full, so that probe sequences stay short.
+static
+void
+build_name_index(tzdb& db)
+{
+    auto n = db.zones.size();
+#if !USE_OS_TZDB
+    n += db.links.size();
+#endif
+    std::size_t size = 16;
+    while (size < 2*n)
+        size *= 2;
+    db.name_index.assign(size, detail::zone_index_entry{0, nullptr, nullptr});
+    auto insert = [&db, size](const std::string& name, const time_zone* z)
+    {
+        auto h = name_hash(name.data(), name.size());
+        for (auto i = h & (size - 1);; i = (i + 1) & (size - 1))
+        {
+            auto& e = db.name_index[i];
+            if (e.name == nullptr)
+            {
+                e = detail::zone_index_entry{h, &name, z};
+                return;
+            }
+            if (e.hash == h && *e.name == name)
+                return;
+        }
+    };
+    for (auto const& z : db.zones)
+        insert(z.name(), &z);
+#if !USE_OS_TZDB
+    for (auto const& l : db.links)
+    {
+        auto const& t = l.target();
+        if (auto z = find_in_name_index(db, t.data(), t.size()))
+            if (z->name() == t)
+                insert(l.name(), z);
+    }
+#endif  // !USE_OS_TZDB
+}
+
+#if !MISSING_LEAP_SECONDS
+
+// Fills in the rest of t from t.dates.
+static
+void
+index_leaps(detail::leap_table& t)
+{
+    t.buckets.clear();
+    if (t.dates.empty())
+    {
+        t.first = t.last = sys_seconds{};
+        return;
+    }
+    t.first = t.dates.front();
+    t.last = t.dates.back();
+    std::size_t i = 0;
+    for (auto b = t.first; b < t.last; b += std::chrono::seconds{std::int64_t{1} << t.shift})
+    {
+        while (t.dates[i] <= b)
+            ++i;
+        t.buckets.push_back(static_cast<std::uint16_t>(i));
+    }
+}
+
+static
+void
+build_leap_index(tzdb& db)
+{
+    auto& t = db.leap_index;
+    t.dates.clear();
+    for (auto const& l : db.leaps)
+        t.dates.push_back(l.date());
+    t.expires = sys_seconds::min();
+    index_leaps(t);
+}
+
+// push_front publishes the leap_index of the new front database, which lives as long
+// as that database.  reload_leap_seconds keeps the tables it publishes for the life
+// of the process, since readers hold on to them without any synchronization.
+std::atomic<const detail::leap_table*> detail::published_leaps{nullptr};
+
+namespace
+{
+
+// mut guards publishing to published_leaps.  loaded is the table last published by
+// reload_leap_seconds, and tables owns every table it has published.
+struct loaded_leap_tables
+{
+    std::mutex                                        mut;
+    const detail::leap_table*                         loaded = nullptr;
+    std::vector<std::unique_ptr<detail::leap_table>> tables;
+};
+
+// Never destroyed, so that a table published by reload_leap_seconds outlives its readers.
+loaded_leap_tables&
+get_loaded_leap_tables()
+{
+    static auto t = new loaded_leap_tables;
+    return *t;
+}
+
+}  // unnamed namespace
+
+// True if a knows of a later leap second than b, or of the same ones for longer.
+static
+bool
+newer_leaps(const detail::leap_table& a, const detail::leap_table& b)
+{
+    auto last_a = a.dates.empty() ? sys_seconds::min() : a.last;
+    auto last_b = b.dates.empty() ? sys_seconds::min() : b.last;
+    if (last_a != last_b)
+        return last_a > last_b;
+    return a.expires > b.expires;
+}
+
+// Publishes the leap_index of a new front database, unless the table last loaded by
+// reload_leap_seconds is still in use and is newer.
+static
+void
+publish_leaps(const tzdb& db)
+{
+    auto& l = get_loaded_leap_tables();
+    std::lock_guard<std::mutex> lock(l.mut);
+    auto cur = detail::published_leaps.load(std::memory_order_relaxed);
+    if (cur != nullptr && cur == l.loaded && newer_leaps(*cur, db.leap_index))
+        return;
+    detail::published_leaps.store(&db.leap_index, std::memory_order_release);
+}
+
+#endif  // !MISSING_LEAP_SECONDS
+
+#if USE_INFO_CACHE
+
+// Bumped by ~tzdb so that a time_zone later allocated at the same address can never
+// be answered from a stale cache entry.
+static std::atomic<std::uint64_t> info_cache_generation{0};
+
+namespace
+{
+
+#if HAS_STRING_VIEW
+// Entries hold the view form, whose abbrev points into storage owned by the zone, and
+// get_info builds its sys_info from that.  So get_info and get_info_view share them.
+using cached_info       = sys_info_view;
+using cached_local_info = local_info_view;
+#else
+using cached_info       = sys_info;
+using cached_local_info = local_info;
+#endif
+
+struct info_cache
+{
+    struct entry
+    {
+        const time_zone* zone = nullptr;
+        std::uint64_t    generation = 0;
+        cached_info      info{};
+    };
+
+    static const std::size_t size = 8;
+
+    entry            entries[size];
+    info_cache_stats stats{};
+
+    entry&
+    slot(const time_zone* z)
+    {
+        return entries[reinterpret_cast<std::uintptr_t>(z) / sizeof(time_zone) % size];
+    }
+};
+
+thread_local info_cache thread_info_cache;
+
+}  // unnamed namespace
+
+static
+bool
+find_cached_info(const time_zone* z, sys_seconds tp, cached_info& r)
+{
+    auto& cache = thread_info_cache;
+    auto& e = cache.slot(z);
+    if (e.zone == z &&
+        e.generation == info_cache_generation.load(std::memory_order_acquire) &&
+        e.info.begin <= tp && tp < e.info.end)
+    {
+        ++cache.stats.hits;
+        r = e.info;
+        return true;
+    }
+    ++cache.stats.misses;
+    return false;
+}
+
+// A local time at least a day away from both ends of the cached period can't be
+// ambiguous or nonexistent.
+static
+bool
+find_cached_info(const time_zone* z, local_seconds tp, cached_local_info& r)
+{
+    using namespace std::chrono;
+    auto& cache = thread_info_cache;
+    auto& e = cache.slot(z);
+    if (e.zone == z &&
+        e.generation == info_cache_generation.load(std::memory_order_acquire))
+    {
+        auto tps = sys_seconds{(tp - e.info.offset).time_since_epoch()};
+        if (e.info.begin + days{1} <= tps && tps < e.info.end - days{1})
+        {
+            ++cache.stats.hits;
+            r.result = cached_local_info::unique;
+            r.first = e.info;
+            r.second = {};
+            return true;
+        }
+    }
+    ++cache.stats.misses;
+    return false;
+}
+
+static
+void
+store_cached_info(const time_zone* z, const cached_info& i)
+{
+    auto& e = thread_info_cache.slot(z);
+    e.zone = z;
+    e.generation = info_cache_generation.load(std::memory_order_acquire);
+    e.info = i;
+}
+
+#if HAS_STRING_VIEW
+
+static
+sys_info
+to_sys_info(const sys_info_view& v)
+{
+    sys_info r;
+    r.begin = v.begin;
+    r.end = v.end;
+    r.offset = v.offset;
+    r.save = v.save;
+    r.abbrev.assign(v.abbrev);
+    return r;
+}
+
+static
+local_info
+to_local_info(const local_info_view& v)
+{
+    local_info r{};
+    switch (v.result)
+    {
+    case local_info_view::unique:
+        r.result = local_info::unique;
+        break;
+    case local_info_view::nonexistent:
+        r.result = local_info::nonexistent;
+        break;
+    case local_info_view::ambiguous:
+        r.result = local_info::ambiguous;
+        break;
+    }
+    r.first = to_sys_info(v.first);
+    r.second = to_sys_info(v.second);
+    return r;
+}
+
+#endif  // HAS_STRING_VIEW
+
+info_cache_stats
+get_info_cache_stats()
+{
+    return thread_info_cache.stats;
+}
+
+void
+reset_info_cache_stats()
+{
+    thread_info_cache.stats = info_cache_stats{};
+}
+
+#endif  // USE_INFO_CACHE
+
+tzdb::~tzdb()
+{
+#if USE_INFO_CACHE
+    ++info_cache_generation;
+#endif
+}
 
 tzdb_list::~tzdb_list()
 {
@@ -410,32 +792,165 @@ tzdb_list::~tzdb_list()
     while (ptr != nullptr)
     {
         auto next = ptr->next;
+#if USE_OS_TZDB && USE_TZDATA_ZI
+        forget_unlisted_zones(ptr);
+#endif
         delete ptr;
         ptr = next;
     }
+    for (auto& r : retired_)
+    {
+#if USE_OS_TZDB && USE_TZDATA_ZI
+        forget_unlisted_zones(r.second);
+#endif
+        delete r.second;
+    }
 }
 
 tzdb_list::tzdb_list(tzdb_list&& x) noexcept
    : head_{x.head_.exchange(nullptr)}
+   , retired_(std::move(x.retired_))
 {
 }
 
 void
 tzdb_list::push_front(tzdb* tzdb) noexcept
 {
-    tzdb->next = head_;
-    head_ = tzdb;
+    std::lock_guard<std::mutex> lock(mut_);
+    tzdb->next = head_.load(std::memory_order_relaxed);
+    // seq_cst, not release:  pin::pin stores its epoch and then loads head_, and
+    // reclaim must not see that slot empty while the pinned reader sees the old head.
+    head_.store(tzdb);
+#if !MISSING_LEAP_SECONDS
+    publish_leaps(*tzdb);
+#endif
 }
 
 tzdb_list::const_iterator
 tzdb_list::erase_after(const_iterator p) noexcept
 {
+    std::lock_guard<std::mutex> lock(mut_);
     auto t = p.p_->next;
     p.p_->next = p.p_->next->next;
+#if USE_OS_TZDB && USE_TZDATA_ZI
+    forget_unlisted_zones(t);
+#endif
     delete t;
     return ++p;
 }
 
+// Epoch based reclamation for tzdb_list.  Each thread that pins owns a reader_slot
+// holding the epoch it pinned at, or 0 while it holds no pin.  retire_after unlinks a
+// database and then advances the epoch, so a pin taken at or after the epoch a
+// database was retired at can no longer reach it.  reclaim frees the databases
+// retired no later than the oldest epoch still pinned.
+
+static std::atomic<std::uint64_t> tzdb_epoch{1};
+
+namespace
+{
+
+struct reader_slot
+{
+    std::atomic<std::uint64_t> epoch{0};
+    std::atomic<bool>          in_use{true};
+    reader_slot*               next = nullptr;
+    unsigned                   depth = 0;  // touched only by the owning thread
+};
+
+// Slots are never freed.  A thread that exits hands its slot on to the next thread
+// that needs one, so there are never more slots than threads that pinned at once.
+std::atomic<reader_slot*> reader_slots{nullptr};
+
+struct reader_slot_owner
+{
+    reader_slot* slot = nullptr;
+
+    reader_slot_owner()
+    {
+        for (auto s = reader_slots.load(); s != nullptr; s = s->next)
+        {
+            bool expected = false;
+            if (!s->in_use.load(std::memory_order_relaxed) &&
+                s->in_use.compare_exchange_strong(expected, true))
+            {
+                slot = s;
+                return;
+            }
+        }
+        slot = new reader_slot;
+        slot->next = reader_slots.load();
+        while (!reader_slots.compare_exchange_weak(slot->next, slot))
+            ;
+    }
+
+    ~reader_slot_owner()
+    {
+        slot->depth = 0;
+        slot->epoch.store(0);
+        slot->in_use.store(false, std::memory_order_release);
+    }
+
+    reader_slot_owner(const reader_slot_owner&) = delete;
+    reader_slot_owner& operator=(const reader_slot_owner&) = delete;
+};
+
+thread_local reader_slot_owner this_thread_reader;
+
+}  // unnamed namespace
+
+tzdb_list::pin::pin()
+{
+    auto s = this_thread_reader.slot;
+    if (s->depth++ == 0)
+        s->epoch.store(tzdb_epoch.load());
+}
+
+tzdb_list::pin::~pin()
+{
+    auto s = this_thread_reader.slot;
+    if (--s->depth == 0)
+        s->epoch.store(0, std::memory_order_release);
+}
+
+tzdb_list::const_iterator
+tzdb_list::retire_after(const_iterator p)
+{
+    std::lock_guard<std::mutex> lock(mut_);
+    retired_.reserve(retired_.size() + 1);
+    auto t = p.p_->next;
+    p.p_->next = t->next;
+    retired_.emplace_back(tzdb_epoch.fetch_add(1) + 1, t);
+    return ++p;
+}
+
+std::size_t
+tzdb_list::reclaim()
+{
+    std::lock_guard<std::mutex> lock(mut_);
+    auto oldest = std::numeric_limits<std::uint64_t>::max();
+    for (auto s = reader_slots.load(); s != nullptr; s = s->next)
+    {
+        auto e = s->epoch.load();
+        if (e != 0 && e < oldest)
+            oldest = e;
+    }
+    auto done = std::partition(retired_.begin(), retired_.end(),
+                               [oldest](const std::pair<std::uint64_t, tzdb*>& r)
+                               {
+                                   return r.first > oldest;
+                               });
+    for (auto i = done; i != retired_.end(); ++i)
+    {
+#if USE_OS_TZDB && USE_TZDATA_ZI
+        forget_unlisted_zones(i->second);
+#endif
+        delete i->second;
+    }
+    retired_.erase(done, retired_.end());
+    return retired_.size();
+}
+
 struct tzdb_list::undocumented_helper
 {
     static void push_front(tzdb_list& db_list, tzdb* tzdb) noexcept
@@ -460,30 +975,136 @@ get_tzdb_list()
     return tz_db;
 }
 
-#if !USE_OS_TZDB
+// line_reader
 
-#ifdef _WIN32
+void
+detail::line_reader::ws()
+{
+    while (p_ != last_ && std::isspace(static_cast<unsigned char>(*p_)))
+        ++p_;
+}
+
+char
+detail::line_reader::get()
+{
+    if (p_ == last_)
+        throw std::runtime_error("Unexpected end of line: " + str());
+    return *p_++;
+}
+
+char
+detail::line_reader::read_char()
+{
+    ws();
+    return get();
+}
+
+int
+detail::line_reader::read_int()
+{
+    ws();
+    auto p = p_;
+    auto neg = false;
+    if (p != last_ && (*p == '-' || *p == '+'))
+        neg = *p++ == '-';
+    if (p == last_ || !std::isdigit(static_cast<unsigned char>(*p)))
+        throw std::runtime_error("Expected a number: " + str());
+    int x = 0;
+    for (; p != last_ && std::isdigit(static_cast<unsigned char>(*p)); ++p)
+    {
+        if (x > (std::numeric_limits<int>::max() - 9) / 10)
+            throw std::runtime_error("Number out of range: " + str());
+        x = 10*x + (*p - '0');
+    }
+    p_ = p;
+    return neg ? -x : x;
+}
 
+std::string
+detail::line_reader::read_word()
+{
+    ws();
+    if (p_ == last_)
+        throw std::runtime_error("Unexpected end of line: " + str());
+    auto p = p_;
+    while (p_ != last_ && !std::isspace(static_cast<unsigned char>(*p_)))
+        ++p_;
+    return std::string(p, p_);
+}
+
+// Calls f(i) for each i in [0, n), spread over up to nthreads threads, the calling
+// thread among them.  nthreads == 0 means std::thread::hardware_concurrency().  If
+// any call throws, the exception from the lowest such i is rethrown after all of the
+// calls have finished.
+template <class F>
 static
 void
-sort_zone_mappings(std::vector<date::detail::timezone_mapping>& mappings)
+parallel_for(std::size_t n, unsigned nthreads, F f)
 {
-    std::sort(mappings.begin(), mappings.end(),
-        [](const date::detail::timezone_mapping& lhs,
-           const date::detail::timezone_mapping& rhs)->bool
+    if (nthreads == 0)
+        nthreads = std::thread::hardware_concurrency();
+    std::vector<std::exception_ptr> errors(n);
+    std::atomic<std::size_t> next{0};
+    auto work = [&]()
     {
-        auto other_result = lhs.other.compare(rhs.other);
-        if (other_result < 0)
-            return true;
-        else if (other_result == 0)
+        for (std::size_t i; (i = next++) < n;)
         {
-            auto territory_result = lhs.territory.compare(rhs.territory);
-            if (territory_result < 0)
-                return true;
-            else if (territory_result == 0)
+            try
             {
-                if (lhs.type < rhs.type)
-                    return true;
+                f(i);
+            }
+            catch (...)
+            {
+                errors[i] = std::current_exception();
+            }
+        }
+    };
+    std::vector<std::thread> threads;
+    for (std::size_t i = 1; i < std::min<std::size_t>(nthreads, n); ++i)
+    {
+        try
+        {
+            threads.emplace_back(work);
+        }
+        catch (const std::system_error&)
+        {
+            break;
+        }
+    }
+    work();
+    for (auto& t : threads)
+        t.join();
+    for (auto& e : errors)
+    {
+        if (e)
+            std::rethrow_exception(e);
+    }
+}
+
+#if !USE_OS_TZDB
+
+#ifdef _WIN32
+
+static
+void
+sort_zone_mappings(std::vector<date::detail::timezone_mapping>& mappings)
+{
+    std::sort(mappings.begin(), mappings.end(),
+        [](const date::detail::timezone_mapping& lhs,
+           const date::detail::timezone_mapping& rhs)->bool
+    {
+        auto other_result = lhs.other.compare(rhs.other);
+        if (other_result < 0)
+            return true;
+        else if (other_result == 0)
+        {
+            auto territory_result = lhs.territory.compare(rhs.territory);
+            if (territory_result < 0)
+                return true;
+            else if (territory_result == 0)
+            {
+                if (lhs.type < rhs.type)
+                    return true;
             }
         }
         return false;
@@ -672,23 +1293,21 @@ load_timezone_mappings_from_xml_file(const std::string& input_path)
 
 #endif  // _WIN32
 
-// Parsing helpers
-
 static
 std::string
-parse3(std::istream& in)
+parse3(detail::line_reader& in)
 {
     std::string r(3, ' ');
-    ws(in);
-    r[0] = static_cast<char>(in.get());
-    r[1] = static_cast<char>(in.get());
-    r[2] = static_cast<char>(in.get());
+    in.ws();
+    r[0] = in.get();
+    r[1] = in.get();
+    r[2] = in.get();
     return r;
 }
 
 static
 unsigned
-parse_dow(std::istream& in)
+parse_dow(detail::line_reader& in)
 {
     CONSTDATA char*const dow_names[] =
         {"Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat"};
@@ -701,7 +1320,7 @@ parse_dow(std::istream& in)
 
 static
 unsigned
-parse_month(std::istream& in)
+parse_month(detail::line_reader& in)
 {
     CONSTDATA char*const month_names[] =
         {"Jan", "Feb", "Mar", "Apr", "May", "Jun",
@@ -715,22 +1334,18 @@ parse_month(std::istream& in)
 
 static
 std::chrono::seconds
-parse_unsigned_time(std::istream& in)
+parse_unsigned_time(detail::line_reader& in)
 {
     using namespace std::chrono;
-    int x;
-    in >> x;
-    auto r = seconds{hours{x}};
+    auto r = seconds{hours{in.read_int()}};
     if (!in.eof() && in.peek() == ':')
     {
         in.get();
-        in >> x;
-        r += minutes{x};
+        r += minutes{in.read_int()};
         if (!in.eof() && in.peek() == ':')
         {
             in.get();
-            in >> x;
-            r += seconds{x};
+            r += seconds{in.read_int()};
         }
     }
     return r;
@@ -738,9 +1353,9 @@ parse_unsigned_time(std::istream& in)
 
 static
 std::chrono::seconds
-parse_signed_time(std::istream& in)
+parse_signed_time(detail::line_reader& in)
 {
-    ws(in);
+    in.ws();
     auto sign = 1;
     if (in.peek() == '-')
     {
@@ -955,18 +1570,18 @@ detail::MonthDayTime::canonicalize(date::year y)
     }
 }
 
-std::istream&
-detail::operator>>(std::istream& is, MonthDayTime& x)
+detail::line_reader&
+detail::operator>>(line_reader& is, MonthDayTime& x)
 {
     using namespace date;
     using namespace std::chrono;
-    assert(((std::ios::failbit | std::ios::badbit) & is.exceptions()) ==
-            (std::ios::failbit | std::ios::badbit));
     x = MonthDayTime{};
-    if (!is.eof() && ws(is) && !is.eof() && is.peek() != '#')
+    is.ws();
+    if (!is.eof() && is.peek() != '#')
     {
         auto m = parse_month(is);
-        if (!is.eof() && ws(is) && !is.eof() && is.peek() != '#')
+        is.ws();
+        if (!is.eof() && is.peek() != '#')
         {
             if (is.peek() == 'l')
             {
@@ -979,16 +1594,13 @@ detail::operator>>(std::istream& is, MonthDayTime& x)
             else if (std::isalpha(is.peek()))
             {
                 auto dow = parse_dow(is);
-                char c{};
-                is >> c;
+                char c = is.read_char();
                 if (c == '<' || c == '>')
                 {
-                    char c2{};
-                    is >> c2;
+                    char c2 = is.read_char();
                     if (c2 != '=')
                         throw std::runtime_error(std::string("bad operator: ") + c + c2);
-                    int d;
-                    is >> d;
+                    int d = is.read_int();
                     if (d < 1 || d > 31)
                         throw std::runtime_error(std::string("bad operator: ") + c + c2
                                  + std::to_string(d));
@@ -1000,36 +1612,30 @@ detail::operator>>(std::istream& is, MonthDayTime& x)
             }
             else  // if (std::isdigit(is.peek())
             {
-                int d;
-                is >> d;
+                int d = is.read_int();
                 if (d < 1 || d > 31)
                     throw std::runtime_error(std::string("day of month: ")
                              + std::to_string(d));
                 x.type_ = MonthDayTime::month_day;
                 x.u = date::month(m)/d;
             }
-            if (!is.eof() && ws(is) && !is.eof() && is.peek() != '#')
+            is.ws();
+            if (!is.eof() && is.peek() != '#')
             {
-                int t;
-                is >> t;
-                x.h_ = hours{t};
+                x.h_ = hours{is.read_int()};
                 if (!is.eof() && is.peek() == ':')
                 {
                     is.get();
-                    is >> t;
-                    x.m_ = minutes{t};
+                    x.m_ = minutes{is.read_int()};
                     if (!is.eof() && is.peek() == ':')
                     {
                         is.get();
-                        is >> t;
-                        x.s_ = seconds{t};
+                        x.s_ = seconds{is.read_int()};
                     }
                 }
                 if (!is.eof() && std::isalpha(is.peek()))
                 {
-                    char c;
-                    is >> c;
-                    switch (c)
+                    switch (is.get())
                     {
                     case 's':
                         x.zone_ = tz::standard;
@@ -1091,20 +1697,22 @@ detail::operator<<(std::ostream& os, const MonthDayTime& x)
 // Rule
 
 detail::Rule::Rule(const std::string& s)
+    : Rule(line_reader(s))
+{
+}
+
+detail::Rule::Rule(line_reader in)
 {
     try
     {
         using namespace date;
         using namespace std::chrono;
-        std::istringstream in(s);
-        in.exceptions(std::ios::failbit | std::ios::badbit);
-        std::string word;
-        in >> word >> name_;
-        int x;
-        ws(in);
+        in.read_word();
+        name_ = in.read_word();
+        in.ws();
         if (std::isalpha(in.peek()))
         {
-            in >> word;
+            auto word = in.read_word();
             if (word == "min")
             {
                 starting_year_ = year::min();
@@ -1114,13 +1722,12 @@ detail::Rule::Rule(const std::string& s)
         }
         else
         {
-            in >> x;
-            starting_year_ = year{x};
+            starting_year_ = year{in.read_int()};
         }
-        std::ws(in);
+        in.ws();
         if (std::isalpha(in.peek()))
         {
-            in >> word;
+            auto word = in.read_word();
             if (word == "only")
             {
                 ending_year_ = starting_year_;
@@ -1134,21 +1741,21 @@ detail::Rule::Rule(const std::string& s)
         }
         else
         {
-            in >> x;
-            ending_year_ = year{x};
+            ending_year_ = year{in.read_int()};
         }
-        in >> word;  // TYPE (always "-")
+        auto word = in.read_word();  // TYPE (always "-")
         assert(word == "-");
+        (void)word;
         in >> starting_at_;
         save_ = duration_cast<minutes>(parse_signed_time(in));
-        in >> abbrev_;
+        abbrev_ = in.read_word();
         if (abbrev_ == "-")
             abbrev_.clear();
         assert(hours{-1} <= save_ && save_ <= hours{2});
     }
     catch (...)
     {
-        std::cerr << s << '\n';
+        std::cerr << in.str() << '\n';
         std::cerr << *this << '\n';
         throw;
     }
@@ -1392,6 +1999,11 @@ void
 detail::Rule::split_overlaps(std::vector<Rule>& rules)
 {
     using difference_type = std::vector<Rule>::iterator::difference_type;
+    // Each name is split in a scratch vector, so that the insertions made by split
+    // only have to shift the rules of that name.
+    std::vector<Rule> result;
+    result.reserve(rules.size());
+    std::vector<Rule> group;
     for (std::size_t i = 0; i < rules.size();)
     {
         auto e = static_cast<std::size_t>(std::upper_bound(
@@ -1400,29 +2012,35 @@ detail::Rule::split_overlaps(std::vector<Rule>& rules)
             {
                 return nm < x.name();
             }) - rules.cbegin());
-        split_overlaps(rules, i, e);
-        auto first_rule = rules.begin() + static_cast<difference_type>(i);
-        auto last_rule = rules.begin() + static_cast<difference_type>(e);
+        group.assign(std::make_move_iterator(rules.begin()+static_cast<difference_type>(i)),
+                     std::make_move_iterator(rules.begin()+static_cast<difference_type>(e)));
+        i = e;
+        e = group.size();
+        split_overlaps(group, 0, e);
+        auto first_rule = group.begin();
+        auto last_rule = group.begin() + static_cast<difference_type>(e);
         auto t = std::lower_bound(first_rule, last_rule, min_year);
         if (t > first_rule+1)
         {
             if (t == last_rule || t->starting_year() >= min_year)
                 --t;
             auto d = static_cast<std::size_t>(t - first_rule);
-            rules.erase(first_rule, t);
+            group.erase(first_rule, t);
             e -= d;
         }
-        first_rule = rules.begin() + static_cast<difference_type>(i);
-        last_rule = rules.begin() + static_cast<difference_type>(e);
+        first_rule = group.begin();
+        last_rule = group.begin() + static_cast<difference_type>(e);
         t = std::upper_bound(first_rule, last_rule, max_year);
         if (t != last_rule)
         {
             auto d = static_cast<std::size_t>(last_rule - t);
-            rules.erase(t, last_rule);
+            group.erase(t, last_rule);
             e -= d;
         }
-        i = e;
+        result.insert(result.end(), std::make_move_iterator(group.begin()),
+                      std::make_move_iterator(group.begin() + static_cast<difference_type>(e)));
     }
+    rules = std::move(result);
     rules.shrink_to_fit();
 }
 
@@ -1433,12 +2051,12 @@ detail::Rule::split_overlaps(std::vector<Rule>& rules)
 // that rule.  If there is no previous rule, returns nullptr and year::min().
 // Preconditions:
 //     r->starting_year() <= y && y <= r->ending_year()
+//     r points into rules
 static
 std::pair<const Rule*, date::year>
-find_previous_rule(const Rule* r, date::year y)
+find_previous_rule(const std::vector<Rule>& rules, const Rule* r, date::year y)
 {
     using namespace date;
-    auto const& rules = get_tzdb().rules;
     if (y == r->starting_year())
     {
         if (r == &rules.front() || r->name() != r[-1].name())
@@ -1500,12 +2118,12 @@ find_next_rule(const Rule* first_rule, const Rule* last_rule, const Rule* r, dat
 // that rule.  If there is no next rule, return nullptr and year::max().
 // Preconditions:
 //     r->starting_year() <= y && y <= r->ending_year()
+//     r points into rules
 static
 std::pair<const Rule*, date::year>
-find_next_rule(const Rule* r, date::year y)
+find_next_rule(const std::vector<Rule>& rules, const Rule* r, date::year y)
 {
     using namespace date;
-    auto const& rules = get_tzdb().rules;
     if (y == r->ending_year())
     {
         if (r == &rules.back() || r->name() != r[1].name())
@@ -1612,7 +2230,8 @@ find_rule_for_zone(const std::pair<const Rule*, const Rule*>& eqr,
 
 static
 sys_info
-find_rule(const std::pair<const Rule*, date::year>& first_rule,
+find_rule(const std::vector<Rule>& rules,
+          const std::pair<const Rule*, date::year>& first_rule,
           const std::pair<const Rule*, date::year>& last_rule,
           const date::year& y, const std::chrono::seconds& offset,
           const MonthDayTime& mdt, const std::chrono::minutes& initial_save,
@@ -1638,19 +2257,19 @@ find_rule(const std::pair<const Rule*, date::year>& first_rule,
             }
             if (tx < tr)
             {
-                std::tie(r, ry) = find_previous_rule(r, ry);  // can't return nullptr for r
+                std::tie(r, ry) = find_previous_rule(rules, r, ry);  // can't return nullptr for r
                 assert(r != nullptr);
             }
             // r != nullptr && tx >= tr (if tr were to be recomputed)
             auto prev_save = initial_save;
             if (!(r == first_rule.first && ry == first_rule.second))
-                prev_save = find_previous_rule(r, ry).first->save();
+                prev_save = find_previous_rule(rules, r, ry).first->save();
             x.begin = r->mdt().to_sys(ry, offset, prev_save);
             x.save = r->save();
             x.abbrev = r->abbrev();
             if (!(r == last_rule.first && ry == last_rule.second))
             {
-                std::tie(r, ry) = find_next_rule(r, ry);  // can't return nullptr for r
+                std::tie(r, ry) = find_next_rule(rules, r, ry);  // can't return nullptr for r
                 assert(r != nullptr);
                 x.end = r->mdt().to_sys(ry, offset, x.save);
             }
@@ -1659,7 +2278,7 @@ find_rule(const std::pair<const Rule*, date::year>& first_rule,
             break;
         }
         x.save = r->save();
-        std::tie(r, ry) = find_next_rule(r, ry);  // Can't return nullptr for r
+        std::tie(r, ry) = find_next_rule(rules, r, ry);  // Can't return nullptr for r
         assert(r != nullptr);
     }
     return x;
@@ -1715,13 +2334,51 @@ detail::zonelet::zonelet(const zonelet& i)
 
 #endif  // !USE_OS_TZDB
 
+// Reads all of the file at path into buf.  Returns false if it can't be opened.
+static
+bool
+read_file(const std::string& path, std::string& buf)
+{
+#ifndef _WIN32
+    auto fd = ::open(path.c_str(), O_RDONLY);
+    if (fd == -1)
+        return false;
+    // One byte more than the size, so that the first read normally sees the end.
+    struct stat sb;
+    buf.resize(::fstat(fd, &sb) == 0 && sb.st_size > 0
+                   ? static_cast<std::size_t>(sb.st_size) + 1 : 4096);
+    std::size_t n = 0;
+    ssize_t k;
+    while ((k = ::read(fd, &buf[n], buf.size() - n)) > 0)
+    {
+        n += static_cast<std::size_t>(k);
+        if (n == buf.size())
+            buf.resize(2 * n);
+    }
+    ::close(fd);
+    buf.resize(n);
+    return k == 0;
+#else  // _WIN32
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open())
+        return false;
+    in.seekg(0, std::ios::end);
+    auto const size = in.tellg();
+    in.seekg(0, std::ios::beg);
+    buf.resize(static_cast<std::size_t>(size));
+    in.read(&buf[0], static_cast<std::streamsize>(buf.size()));
+    buf.resize(static_cast<std::size_t>(in.gcount()));
+    return true;
+#endif  // _WIN32
+}
+
 // time_zone
 
 #if USE_OS_TZDB
 
 time_zone::time_zone(const std::string& s, detail::undocumented)
     : name_(s)
-    , adjusted_(new std::once_flag{})
+    , adjusted_(new detail::zone_state)
 {
 }
 
@@ -1794,241 +2451,396 @@ maybe_reverse_bytes(T& t)
                                                   endian::native == endian::little>{});
 }
 
-static
-void
-load_header(std::istream& inf)
-{
-    // Read TZif
-    auto t = inf.get();
-    auto z = inf.get();
-    auto i = inf.get();
-    auto f = inf.get();
-#ifndef NDEBUG
-    assert(t == 'T');
-    assert(z == 'Z');
-    assert(i == 'i');
-    assert(f == 'f');
-#else
-    (void)t;
-    (void)z;
-    (void)i;
-    (void)f;
-#endif
-}
+// TZif files are read whole and decoded from memory.  All of their multi-byte fields
+// are big endian.
 
+template <class T>
 static
-unsigned char
-load_version(std::istream& inf)
+inline
+T
+load_big_endian(const char* p)
 {
-    // Read version
-    auto v = inf.get();
-    assert(v != EOF);
-    return static_cast<unsigned char>(v);
+    T t;
+    std::memcpy(&t, p, sizeof(t));
+    maybe_reverse_bytes(t);
+    return t;
 }
 
-static
-void
-skip_reserve(std::istream& inf)
-{
-    inf.ignore(15);
-}
+CONSTDATA std::size_t tzif_header_size = 44;
 
+// The size of the data block following a TZif header with these counts.
 static
-void
-load_counts(std::istream& inf,
+std::size_t
+tzif_data_size(std::size_t time_size,
+               std::int32_t tzh_ttisgmtcnt, std::int32_t tzh_ttisstdcnt,
+               std::int32_t tzh_leapcnt,    std::int32_t tzh_timecnt,
+               std::int32_t tzh_typecnt,    std::int32_t tzh_charcnt)
+{
+    return (time_size + 1) * static_cast<std::size_t>(tzh_timecnt) +
+           6 * static_cast<std::size_t>(tzh_typecnt) +
+           static_cast<std::size_t>(tzh_charcnt) +
+           (time_size + 4) * static_cast<std::size_t>(tzh_leapcnt) +
+           static_cast<std::size_t>(tzh_ttisstdcnt) +
+           static_cast<std::size_t>(tzh_ttisgmtcnt);
+}
+
+// Reads the TZif header at p, and checks that the data block it describes is
+// within [p, last).  Returns the version.
+static
+unsigned char
+load_header(const char* p, const char* last, std::size_t time_size,
             std::int32_t& tzh_ttisgmtcnt, std::int32_t& tzh_ttisstdcnt,
             std::int32_t& tzh_leapcnt,    std::int32_t& tzh_timecnt,
             std::int32_t& tzh_typecnt,    std::int32_t& tzh_charcnt)
 {
-    // Read counts;
-    inf.read(reinterpret_cast<char*>(&tzh_ttisgmtcnt), 4);
-    maybe_reverse_bytes(tzh_ttisgmtcnt);
-    inf.read(reinterpret_cast<char*>(&tzh_ttisstdcnt), 4);
-    maybe_reverse_bytes(tzh_ttisstdcnt);
-    inf.read(reinterpret_cast<char*>(&tzh_leapcnt), 4);
-    maybe_reverse_bytes(tzh_leapcnt);
-    inf.read(reinterpret_cast<char*>(&tzh_timecnt), 4);
-    maybe_reverse_bytes(tzh_timecnt);
-    inf.read(reinterpret_cast<char*>(&tzh_typecnt), 4);
-    maybe_reverse_bytes(tzh_typecnt);
-    inf.read(reinterpret_cast<char*>(&tzh_charcnt), 4);
-    maybe_reverse_bytes(tzh_charcnt);
+    if (static_cast<std::size_t>(last - p) < tzif_header_size ||
+        std::memcmp(p, "TZif", 4) != 0)
+        throw std::runtime_error("Invalid TZif data");
+    auto v = static_cast<unsigned char>(p[4]);
+    p += 20;
+    tzh_ttisgmtcnt = load_big_endian<std::int32_t>(p);
+    tzh_ttisstdcnt = load_big_endian<std::int32_t>(p + 4);
+    tzh_leapcnt    = load_big_endian<std::int32_t>(p + 8);
+    tzh_timecnt    = load_big_endian<std::int32_t>(p + 12);
+    tzh_typecnt    = load_big_endian<std::int32_t>(p + 16);
+    tzh_charcnt    = load_big_endian<std::int32_t>(p + 20);
+    p += 24;
+    if (tzh_ttisgmtcnt < 0 || tzh_ttisstdcnt < 0 || tzh_leapcnt < 0 ||
+        tzh_timecnt < 0 || tzh_typecnt < 0 || tzh_charcnt < 0 ||
+        static_cast<std::size_t>(last - p) <
+            tzif_data_size(time_size, tzh_ttisgmtcnt, tzh_ttisstdcnt, tzh_leapcnt,
+                                      tzh_timecnt,    tzh_typecnt,    tzh_charcnt))
+        throw std::runtime_error("Invalid TZif data");
+    return v;
+}
+
+// Finds the data block to decode in the TZif file [p, last):  the 64 bit one if the
+// file is version 2 or later, else the 32 bit one.  Sets the counts from its header
+// and returns a pointer to it.
+static
+const char*
+find_tzif_data(const char* p, const char* last, bool& is_64_bit,
+               std::int32_t& tzh_ttisgmtcnt, std::int32_t& tzh_ttisstdcnt,
+               std::int32_t& tzh_leapcnt,    std::int32_t& tzh_timecnt,
+               std::int32_t& tzh_typecnt,    std::int32_t& tzh_charcnt)
+{
+    auto v = load_header(p, last, 4, tzh_ttisgmtcnt, tzh_ttisstdcnt, tzh_leapcnt,
+                                     tzh_timecnt,    tzh_typecnt,    tzh_charcnt);
+    p += tzif_header_size;
+    is_64_bit = v != 0;
+    if (!is_64_bit)
+        return p;
+    p += tzif_data_size(4, tzh_ttisgmtcnt, tzh_ttisstdcnt, tzh_leapcnt,
+                           tzh_timecnt,    tzh_typecnt,    tzh_charcnt);
+    load_header(p, last, 8, tzh_ttisgmtcnt, tzh_ttisstdcnt, tzh_leapcnt,
+                            tzh_timecnt,    tzh_typecnt,    tzh_charcnt);
+    return p + tzif_header_size;
 }
 
+#if !MISSING_LEAP_SECONDS
+
 template <class TimeType>
 static
-std::vector<detail::transition>
-load_transitions(std::istream& inf, std::int32_t tzh_timecnt)
+std::vector<leap>
+load_leaps(const char* p, std::int32_t tzh_leapcnt)
 {
-    // Read transitions
+    // Read tzh_leapcnt pairs
     using namespace std::chrono;
-    std::vector<detail::transition> transitions;
-    transitions.reserve(static_cast<unsigned>(tzh_timecnt));
-    for (std::int32_t i = 0; i < tzh_timecnt; ++i)
+    std::vector<leap> leap_seconds;
+    leap_seconds.reserve(static_cast<std::size_t>(tzh_leapcnt));
+    for (std::int32_t i = 0; i < tzh_leapcnt; ++i, p += sizeof(TimeType) + 4)
     {
-        TimeType t;
-        inf.read(reinterpret_cast<char*>(&t), sizeof(t));
-        maybe_reverse_bytes(t);
-        transitions.emplace_back(sys_seconds{seconds{t}});
-        if (transitions.back().timepoint < min_seconds)
-            transitions.back().timepoint = min_seconds;
+        auto t0 = load_big_endian<TimeType>(p);
+        auto t1 = load_big_endian<std::int32_t>(p + sizeof(TimeType));
+        leap_seconds.emplace_back(sys_seconds{seconds{t0 - (t1-1)}},
+                                  detail::undocumented{});
     }
-    return transitions;
+    return leap_seconds;
 }
 
 static
-std::vector<std::uint8_t>
-load_indices(std::istream& inf, std::int32_t tzh_timecnt)
+std::vector<leap>
+load_just_leaps(const std::string& buf)
 {
-    // Read indices
-    std::vector<std::uint8_t> indices;
-    indices.reserve(static_cast<unsigned>(tzh_timecnt));
-    for (std::int32_t i = 0; i < tzh_timecnt; ++i)
-    {
-        std::uint8_t t;
-        inf.read(reinterpret_cast<char*>(&t), sizeof(t));
-        indices.emplace_back(t);
-    }
-    return indices;
+    bool is_64_bit;
+    std::int32_t tzh_ttisgmtcnt, tzh_ttisstdcnt, tzh_leapcnt,
+                 tzh_timecnt,    tzh_typecnt,    tzh_charcnt;
+    auto p = find_tzif_data(buf.data(), buf.data() + buf.size(), is_64_bit,
+                            tzh_ttisgmtcnt, tzh_ttisstdcnt, tzh_leapcnt,
+                            tzh_timecnt,    tzh_typecnt,    tzh_charcnt);
+    auto const time_size = is_64_bit ? 8u : 4u;
+    p += (time_size + 1) * static_cast<std::size_t>(tzh_timecnt) +
+         6 * static_cast<std::size_t>(tzh_typecnt) + static_cast<std::size_t>(tzh_charcnt);
+    if (is_64_bit)
+        return load_leaps<std::int64_t>(p, tzh_leapcnt);
+    return load_leaps<std::int32_t>(p, tzh_leapcnt);
 }
 
-static
-std::vector<ttinfo>
-load_ttinfo(std::istream& inf, std::int32_t tzh_typecnt)
+#endif  // !MISSING_LEAP_SECONDS
+
+namespace detail
 {
-    // Read ttinfo
-    std::vector<ttinfo> ttinfos;
-    ttinfos.reserve(static_cast<unsigned>(tzh_typecnt));
-    for (std::int32_t i = 0; i < tzh_typecnt; ++i)
-    {
-        ttinfo t;
-        inf.read(reinterpret_cast<char*>(&t), 6);
-        maybe_reverse_bytes(t.tt_gmtoff);
-        ttinfos.emplace_back(t);
-    }
-    return ttinfos;
-}
 
-static
-std::string
-load_abbreviations(std::istream& inf, std::int32_t tzh_charcnt)
+// The POSIX TZ string from the footer of a version 2+ TZif file.  Its rules give the
+// transitions after the last one stored in the file.  When there are no rules,
+// std_info is in effect from then on.
+struct posix_footer
 {
-    // Read abbreviations
-    std::string abbrev;
-    abbrev.resize(static_cast<unsigned>(tzh_charcnt), '\0');
-    inf.read(&abbrev[0], tzh_charcnt);
-    return abbrev;
-}
+    expanded_ttinfo     std_info;
+    expanded_ttinfo     dst_info;
+    Posix::detail::rule start_rule;
+    Posix::detail::rule end_rule;
+};
 
-#if !MISSING_LEAP_SECONDS
+}  // namespace detail
 
-template <class TimeType>
+// Parses the footer that follows the data block ending at p.  Returns nullptr if
+// there isn't one, or if it can't be parsed.
 static
-std::vector<leap>
-load_leaps(std::istream& inf, std::int32_t tzh_leapcnt)
+std::shared_ptr<const detail::posix_footer>
+load_footer(const char* p, const char* last)
 {
-    // Read tzh_leapcnt pairs
     using namespace std::chrono;
-    std::vector<leap> leap_seconds;
-    leap_seconds.reserve(static_cast<std::size_t>(tzh_leapcnt));
-    for (std::int32_t i = 0; i < tzh_leapcnt; ++i)
-    {
-        TimeType     t0;
-        std::int32_t t1;
-        inf.read(reinterpret_cast<char*>(&t0), sizeof(t0));
-        inf.read(reinterpret_cast<char*>(&t1), sizeof(t1));
-        maybe_reverse_bytes(t0);
-        maybe_reverse_bytes(t1);
-        leap_seconds.emplace_back(sys_seconds{seconds{t0 - (t1-1)}},
-                                  detail::undocumented{});
+    using Posix::detail::read_name;
+    using Posix::detail::read_signed_time;
+    using Posix::detail::read_date;
+    if (p == last || *p != '\n')
+        return nullptr;
+    ++p;
+    auto e = static_cast<const char*>(std::memchr(p, '\n', static_cast<std::size_t>(last - p)));
+    if (e == nullptr || e == p)
+        return nullptr;
+    const std::string s(p, e);
+    auto f = std::make_shared<detail::posix_footer>();
+    try
+    {
+        seconds offset;
+        auto i = read_name(s, 0, f->std_info.abbrev);
+        i = read_signed_time(s, i, offset);
+        f->std_info.offset = -offset;
+        f->std_info.is_dst = false;
+        if (i != s.size())
+        {
+            i = read_name(s, i, f->dst_info.abbrev);
+            f->dst_info.offset = f->std_info.offset + hours{1};
+            f->dst_info.is_dst = true;
+            if (i != s.size() && s[i] != ',')
+            {
+                i = read_signed_time(s, i, offset);
+                f->dst_info.offset = -offset;
+            }
+            if (i == s.size() || s[i] != ',')
+                return nullptr;
+            i = read_date(s, i+1, f->start_rule);
+            if (i == s.size() || s[i] != ',')
+                return nullptr;
+            i = read_date(s, i+1, f->end_rule);
+        }
+        if (i != s.size())
+            return nullptr;
     }
-    return leap_seconds;
+    catch (const std::runtime_error&)
+    {
+        return nullptr;
+    }
+    return f;
 }
 
-template <class TimeType>
+struct footer_period
+{
+    sys_seconds                    begin;
+    sys_seconds                    end;
+    const detail::expanded_ttinfo* info;
+};
+
+// Finds the period of footer f that tp is in.  The transitions are computed from the
+// rules for the years around tp, so this costs the same however far tp is from the
+// last transition in the file.  begin is not earlier than first, the last transition
+// in the file, and end is year::max() if there are no more transitions.
 static
-std::vector<leap>
-load_leap_data(std::istream& inf,
-               std::int32_t tzh_leapcnt, std::int32_t tzh_timecnt,
-               std::int32_t tzh_typecnt, std::int32_t tzh_charcnt)
+footer_period
+find_footer_period(const detail::posix_footer& f, sys_seconds tp, sys_seconds first)
 {
-    inf.ignore(tzh_timecnt*static_cast<std::int32_t>(sizeof(TimeType)) + tzh_timecnt +
-               tzh_typecnt*6 + tzh_charcnt);
-    return load_leaps<TimeType>(inf, tzh_leapcnt);
+    using namespace std::chrono;
+    using namespace date;
+    const sys_seconds max_seconds = sys_days(year::max()/max_day);
+    if (!f.start_rule.ok())
+        return {first, max_seconds, &f.std_info};
+    struct event
+    {
+        sys_seconds                    tp;
+        const detail::expanded_ttinfo* info;
+    };
+    auto start = [&f](year yy)
+    {
+        return event{sys_seconds{(f.start_rule(yy) - f.std_info.offset).time_since_epoch()},
+                     &f.dst_info};
+    };
+    auto end = [&f](year yy)
+    {
+        return event{sys_seconds{(f.end_rule(yy) - f.dst_info.offset).time_since_epoch()},
+                     &f.std_info};
+    };
+    // Years are only considered within [year::min(), year::max()], where year
+    // arithmetic is defined.
+    auto const y = year_month_day{floor<days>(std::max(std::min(tp, max_seconds),
+                                                       min_seconds))}.year();
+    auto const lo = y > year::min() ? y - years{1} : y;
+    auto const hi = y < year::max() ? y + years{1} : y;
+    // When daylight saving time lasts all year, each year's end and the next year's
+    // start are at the same time, so there are no transitions at all.  Otherwise the
+    // periods found for different years would each end at the last event considered.
+    if (end(lo).tp == start(lo + years{1}).tp)
+        return {first, max_seconds, &f.dst_info};
+    event ev[6];
+    auto n = 0;
+    for (auto yy = lo;; yy += years{1})
+    {
+        ev[n++] = start(yy);
+        ev[n++] = end(yy);
+        if (yy == hi)
+            break;
+    }
+    // A rule may still make a particular year's end and the next year's start meet.
+    // Drop such empty periods, and then merge the neighbors that they separated.
+    std::stable_sort(ev, ev + n, [](const event& a, const event& b) {return a.tp < b.tp;});
+    auto m = 0;
+    for (auto k = 0; k < n; ++k)
+    {
+        if (k + 1 < n && ev[k].tp == ev[k+1].tp)
+            continue;
+        if (m > 0 && ev[m-1].info == ev[k].info)
+            continue;
+        ev[m++] = ev[k];
+    }
+    auto k = std::upper_bound(ev, ev + m, tp,
+                              [](sys_seconds t, const event& x) {return t < x.tp;}) - ev;
+    footer_period r;
+    if (k == 0)
+        r = {first, ev[0].tp, ev[0].info == &f.dst_info ? &f.std_info : &f.dst_info};
+    else
+        r = {ev[k-1].tp, k == m ? max_seconds : ev[k].tp, ev[k-1].info};
+    if (r.begin < first)
+        r.begin = first;
+    if (r.end > max_seconds)
+        r.end = max_seconds;
+    return r;
 }
 
+// Finds the local_info for tp from get, which gives the sys_info (or sys_info_view)
+// for a sys time.  tp is within a day of the sys time it maps to, and periods are
+// longer than that, so the answer is among the period tp would be in if it were a
+// sys time and its two neighbors.
+template <class LocalInfo, class GetInfo>
 static
-std::vector<leap>
-load_just_leaps(std::istream& inf)
+LocalInfo
+local_info_from_sys(local_seconds tp, GetInfo get)
 {
-    // Read tzh_leapcnt pairs
     using namespace std::chrono;
-    load_header(inf);
-    auto v = load_version(inf);
-    std::int32_t tzh_ttisgmtcnt, tzh_ttisstdcnt, tzh_leapcnt,
-                 tzh_timecnt,    tzh_typecnt,    tzh_charcnt;
-    skip_reserve(inf);
-    load_counts(inf, tzh_ttisgmtcnt, tzh_ttisstdcnt, tzh_leapcnt,
-                     tzh_timecnt,    tzh_typecnt,    tzh_charcnt);
-    if (v == 0)
-        return load_leap_data<int32_t>(inf, tzh_leapcnt, tzh_timecnt, tzh_typecnt,
-                                       tzh_charcnt);
-#if !defined(NDEBUG)
-    inf.ignore((4+1)*tzh_timecnt + 6*tzh_typecnt + tzh_charcnt + 8*tzh_leapcnt +
-               tzh_ttisstdcnt + tzh_ttisgmtcnt);
-    load_header(inf);
-    auto v2 = load_version(inf);
-    assert(v == v2);
-    skip_reserve(inf);
-#else  // defined(NDEBUG)
-    inf.ignore((4+1)*tzh_timecnt + 6*tzh_typecnt + tzh_charcnt + 8*tzh_leapcnt +
-               tzh_ttisstdcnt + tzh_ttisgmtcnt + (4+1+15));
-#endif  // defined(NDEBUG)
-    load_counts(inf, tzh_ttisgmtcnt, tzh_ttisstdcnt, tzh_leapcnt,
-                     tzh_timecnt,    tzh_typecnt,    tzh_charcnt);
-    return load_leap_data<int64_t>(inf, tzh_leapcnt, tzh_timecnt, tzh_typecnt,
-                                   tzh_charcnt);
+    using namespace date;
+    auto const ts = sys_seconds{tp.time_since_epoch()};
+    auto a = get(ts);
+    decltype(a) c[3];
+    auto n = 0;
+    if (a.begin > sys_days(year::min()/min_day))
+        c[n++] = get(a.begin - seconds{1});
+    c[n++] = a;
+    if (a.end < sys_days(year::max()/max_day))
+        c[n++] = get(a.end);
+    LocalInfo r{};
+    r.result = LocalInfo::unique;
+    auto found = 0;
+    for (auto k = 0; k < n && found < 2; ++k)
+    {
+        auto t = ts - c[k].offset;
+        if (c[k].begin <= t && t < c[k].end)
+        {
+            if (found++ == 0)
+            {
+                r.first = c[k];
+            }
+            else
+            {
+                r.second = c[k];
+                r.result = LocalInfo::ambiguous;
+            }
+        }
+    }
+    if (found == 0)
+    {
+        r.first = a;
+        for (auto k = 0; k + 1 < n; ++k)
+        {
+            if (ts - c[k].offset >= c[k].end && ts - c[k+1].offset < c[k+1].begin)
+            {
+                r.first = c[k];
+                r.second = c[k+1];
+                r.result = LocalInfo::nonexistent;
+                break;
+            }
+        }
+    }
+    return r;
 }
 
-#endif  // !MISSING_LEAP_SECONDS
-
+// Decodes the data block at p, which load_header has already checked.
 template <class TimeType>
 void
-time_zone::load_data(std::istream& inf,
+time_zone::load_data(const char* p,
                      std::int32_t tzh_leapcnt, std::int32_t tzh_timecnt,
                      std::int32_t tzh_typecnt, std::int32_t tzh_charcnt)
 {
     using namespace std::chrono;
-    transitions_ = load_transitions<TimeType>(inf, tzh_timecnt);
-    auto indices = load_indices(inf, tzh_timecnt);
-    auto infos = load_ttinfo(inf, tzh_typecnt);
-    auto abbrev = load_abbreviations(inf, tzh_charcnt);
+    auto const timecnt = static_cast<std::size_t>(tzh_timecnt);
+    auto const typecnt = static_cast<std::size_t>(tzh_typecnt);
+    auto const charcnt = static_cast<std::size_t>(tzh_charcnt);
+    auto const times = p;
+    auto const indices = reinterpret_cast<const unsigned char*>(times) +
+                         timecnt * sizeof(TimeType);
+    auto const infos = reinterpret_cast<const char*>(indices) + timecnt;
+    auto const abbrevs = infos + 6 * typecnt;
+    // The abbreviations are used as C strings, so make sure that the last one ends.
+    const std::string abbrev(abbrevs, charcnt);
 #if !MISSING_LEAP_SECONDS
     auto& leap_seconds = get_tzdb_list().front().leaps;
     if (leap_seconds.empty() && tzh_leapcnt > 0)
-        leap_seconds = load_leaps<TimeType>(inf, tzh_leapcnt);
+        leap_seconds = load_leaps<TimeType>(abbrevs + charcnt, tzh_leapcnt);
 #endif
-    ttinfos_.reserve(infos.size());
-    for (auto& info : infos)
+    ttinfos_.reserve(typecnt);
+    for (std::size_t i = 0; i < typecnt; ++i)
     {
-        ttinfos_.push_back({seconds{info.tt_gmtoff},
-                            abbrev.c_str() + info.tt_abbrind,
-                            info.tt_isdst != 0});
+        auto info = infos + 6 * i;
+        auto abbrind = static_cast<unsigned char>(info[5]);
+        if (abbrind >= charcnt)
+            throw std::runtime_error("Invalid TZif data for " + name_);
+        ttinfos_.push_back({seconds{load_big_endian<std::int32_t>(info)},
+                            abbrev.c_str() + abbrind,
+                            info[4] != 0});
     }
-    auto i = 0u;
-    if (transitions_.empty() || transitions_.front().timepoint != min_seconds)
+    if (ttinfos_.empty())
+        throw std::runtime_error("Invalid TZif data for " + name_);
+    transitions_.reserve(timecnt + 1);
+    auto load_time = [times](std::size_t i)
+    {
+        auto tp = sys_seconds{seconds{load_big_endian<TimeType>(times +
+                                                                i * sizeof(TimeType))}};
+        return tp < min_seconds ? min_seconds : tp;
+    };
+    if (timecnt == 0 || load_time(0) != min_seconds)
     {
-        transitions_.emplace(transitions_.begin(), min_seconds);
         auto tf = std::find_if(ttinfos_.begin(), ttinfos_.end(),
                                [](const expanded_ttinfo& ti)
                                    {return ti.is_dst == 0;});
         if (tf == ttinfos_.end())
             tf = ttinfos_.begin();
-        transitions_[i].info = &*tf;
-        ++i;
+        transitions_.emplace_back(min_seconds, &*tf);
+    }
+    for (std::size_t i = 0; i < timecnt; ++i)
+    {
+        if (indices[i] >= typecnt)
+            throw std::runtime_error("Invalid TZif data for " + name_);
+        transitions_.emplace_back(load_time(i), ttinfos_.data() + indices[i]);
     }
-    for (auto j = 0u; i < transitions_.size(); ++i, ++j)
-        transitions_[i].info = ttinfos_.data() + indices[j];
 }
 
 void
@@ -2037,38 +2849,25 @@ time_zone::init_impl()
     using namespace std;
     using namespace std::chrono;
     auto name = get_tz_dir() + ('/' + name_);
-    std::ifstream inf(name);
-    if (!inf.is_open())
+    std::string buf;
+    if (!read_file(name, buf))
         throw std::runtime_error{"Unable to open " + name};
-    inf.exceptions(std::ios::failbit | std::ios::badbit);
-    load_header(inf);
-    auto v = load_version(inf);
+    bool is_64_bit;
     std::int32_t tzh_ttisgmtcnt, tzh_ttisstdcnt, tzh_leapcnt,
                  tzh_timecnt,    tzh_typecnt,    tzh_charcnt;
-    skip_reserve(inf);
-    load_counts(inf, tzh_ttisgmtcnt, tzh_ttisstdcnt, tzh_leapcnt,
-                     tzh_timecnt,    tzh_typecnt,    tzh_charcnt);
-    if (v == 0)
+    auto p = find_tzif_data(buf.data(), buf.data() + buf.size(), is_64_bit,
+                            tzh_ttisgmtcnt, tzh_ttisstdcnt, tzh_leapcnt,
+                            tzh_timecnt,    tzh_typecnt,    tzh_charcnt);
+    if (is_64_bit)
     {
-        load_data<int32_t>(inf, tzh_leapcnt, tzh_timecnt, tzh_typecnt, tzh_charcnt);
+        load_data<int64_t>(p, tzh_leapcnt, tzh_timecnt, tzh_typecnt, tzh_charcnt);
+        footer_ = load_footer(p + tzif_data_size(8, tzh_ttisgmtcnt, tzh_ttisstdcnt,
+                                                    tzh_leapcnt,    tzh_timecnt,
+                                                    tzh_typecnt,    tzh_charcnt),
+                              buf.data() + buf.size());
     }
     else
-    {
-#if !defined(NDEBUG)
-        inf.ignore((4+1)*tzh_timecnt + 6*tzh_typecnt + tzh_charcnt + 8*tzh_leapcnt +
-                   tzh_ttisstdcnt + tzh_ttisgmtcnt);
-        load_header(inf);
-        auto v2 = load_version(inf);
-        assert(v == v2);
-        skip_reserve(inf);
-#else  // defined(NDEBUG)
-        inf.ignore((4+1)*tzh_timecnt + 6*tzh_typecnt + tzh_charcnt + 8*tzh_leapcnt +
-                   tzh_ttisstdcnt + tzh_ttisgmtcnt + (4+1+15));
-#endif  // defined(NDEBUG)
-        load_counts(inf, tzh_ttisgmtcnt, tzh_ttisstdcnt, tzh_leapcnt,
-                         tzh_timecnt,    tzh_typecnt,    tzh_charcnt);
-        load_data<int64_t>(inf, tzh_leapcnt, tzh_timecnt, tzh_typecnt, tzh_charcnt);
-    }
+        load_data<int32_t>(p, tzh_leapcnt, tzh_timecnt, tzh_typecnt, tzh_charcnt);
 #if !MISSING_LEAP_SECONDS
     if (tzh_leapcnt > 0)
     {
@@ -2107,12 +2906,90 @@ time_zone::init_impl()
                 i = transitions_.erase(i);
         }
     }
+    build_index();
+}
+
+static
+std::uint32_t
+eytzinger_order(std::vector<std::uint32_t>& index, std::uint32_t i, std::size_t k)
+{
+    if (k < index.size())
+    {
+        i = eytzinger_order(index, i, 2*k);
+        index[k] = i++;
+        i = eytzinger_order(index, i, 2*k+1);
+    }
+    return i;
+}
+
+// Returns the slot of the first key greater than x, or 0 if there is none.
+template <class Key>
+static
+std::size_t
+eytzinger_upper_bound(const std::vector<Key>& keys, Key x)
+{
+    std::size_t k = 1;
+    while (k < keys.size())
+    {
+#ifdef __GNUC__
+        // The great-grandchildren of k start at 16k, sharing two cache lines.
+        __builtin_prefetch(keys.data() + 16*k);
+#endif
+        k = 2*k + !(x < keys[k]);
+    }
+    // Strip the trailing right turns and then the last left turn.
+#ifdef __GNUC__
+    k >>= __builtin_ctzll(~static_cast<unsigned long long>(k)) + 1;
+#else
+    while (k & 1)
+        k >>= 1;
+    k >>= 1;
+#endif
+    return k;
+}
+
+void
+time_zone::build_index()
+{
+    auto n = transitions_.size();
+    key_index_.assign(n+1, 0);
+    eytzinger_order(key_index_, 0, 1);
+    sys_keys_.resize(n+1);
+    local_keys_.resize(n+1);
+    for (std::size_t k = 1; k <= n; ++k)
+    {
+        auto const& t = transitions_[key_index_[k]];
+        sys_keys_[k] = t.timepoint;
+        local_keys_[k] = local_seconds{t.timepoint.time_since_epoch()} + t.info->offset;
+    }
+}
+
+// These are upper_bound over transitions_, comparing against t.timepoint and
+// t.timepoint + t.info->offset respectively.
+
+std::vector<detail::transition>::const_iterator
+time_zone::find_transition(sys_seconds tp) const
+{
+    auto k = eytzinger_upper_bound(sys_keys_, tp);
+    return k == 0 ? transitions_.end() : transitions_.begin() + key_index_[k];
+}
+
+std::vector<detail::transition>::const_iterator
+time_zone::find_transition(local_seconds tp) const
+{
+    auto k = eytzinger_upper_bound(local_keys_, tp);
+    return k == 0 ? transitions_.end() : transitions_.begin() + key_index_[k];
 }
 
 void
 time_zone::init() const
 {
-    std::call_once(*adjusted_, [this]() {const_cast<time_zone*>(this)->init_impl();});
+    std::call_once(adjusted_->once,
+                   [this]()
+                   {
+                       const_cast<time_zone*>(this)->init_impl();
+                       adjusted_->done.store(true, std::memory_order_release);
+                   });
 }
 
 sys_info
@@ -2123,39 +3000,85 @@ time_zone::load_sys_info(std::vector<detail::transition>::const_iterator i) cons
     assert(i != transitions_.begin());
     sys_info r;
     r.begin = i[-1].timepoint;
-    r.end = i != transitions_.end() ? i->timepoint :
-                                      sys_seconds(sys_days(year::max()/max_day));
+    if (i != transitions_.end())
+        r.end = i->timepoint;
+    else if (footer_)
+        r.end = find_footer_period(*footer_, r.begin, r.begin).end;
+    else
+        r.end = sys_days(year::max()/max_day);
     r.offset = i[-1].info->offset;
     r.save = i[-1].info->is_dst ? minutes{1} : minutes{0};
     r.abbrev = i[-1].info->abbrev;
     return r;
 }
 
+// The sys_info for a tp that is after the last transition in the file.
+sys_info
+time_zone::load_footer_info(sys_seconds tp) const
+{
+    using namespace std::chrono;
+    auto p = find_footer_period(*footer_, tp, transitions_.back().timepoint);
+    sys_info r;
+    r.begin = p.begin;
+    r.end = p.end;
+    r.offset = p.info->offset;
+    r.save = p.info->is_dst ? minutes{1} : minutes{0};
+    r.abbrev = p.info->abbrev;
+    return r;
+}
+
 sys_info
 time_zone::get_info_impl(sys_seconds tp) const
 {
     using namespace std;
+#if USE_INFO_CACHE && HAS_STRING_VIEW
+    // The cache holds views.
+    return to_sys_info(get_info_view_impl(tp));
+#else  // !(USE_INFO_CACHE && HAS_STRING_VIEW)
+#if USE_INFO_CACHE
+    sys_info r;
+    if (find_cached_info(this, tp, r))
+        return r;
+#endif
     init();
-    return load_sys_info(upper_bound(transitions_.begin(), transitions_.end(), tp,
-                                     [](const sys_seconds& x, const transition& t)
-                                     {
-                                         return x < t.timepoint;
-                                     }));
+    auto i = find_transition(tp);
+#if USE_INFO_CACHE
+    r = i == transitions_.end() && footer_ ? load_footer_info(tp) : load_sys_info(i);
+    store_cached_info(this, r);
+    return r;
+#else
+    if (i == transitions_.end() && footer_)
+        return load_footer_info(tp);
+    return load_sys_info(i);
+#endif
+#endif  // !(USE_INFO_CACHE && HAS_STRING_VIEW)
 }
 
 local_info
 time_zone::get_info_impl(local_seconds tp) const
 {
     using namespace std::chrono;
-    init();
+#if USE_INFO_CACHE && HAS_STRING_VIEW
+    return to_local_info(get_info_view_impl(tp));
+#else  // !(USE_INFO_CACHE && HAS_STRING_VIEW)
     local_info i;
+#if USE_INFO_CACHE
+    if (find_cached_info(this, tp, i))
+        return i;
+#endif
+    init();
+    auto tr = find_transition(tp);
+    if (tr == transitions_.end() && footer_)
+    {
+        i = local_info_from_sys<local_info>(tp,
+                [this](sys_seconds t) {return get_info_impl(t);});
+#if USE_INFO_CACHE
+        if (i.result == local_info::unique)
+            store_cached_info(this, i.first);
+#endif
+        return i;
+    }
     i.result = local_info::unique;
-    auto tr = upper_bound(transitions_.begin(), transitions_.end(), tp,
-                          [](const local_seconds& x, const transition& t)
-                          {
-                              return sys_seconds{x.time_since_epoch()} -
-                                                         t.info->offset < t.timepoint;
-                          });
     i.first = load_sys_info(tr);
     auto tps = sys_seconds{(tp - i.first.offset).time_since_epoch()};
     if (tps < i.first.begin + days{1} && tr != transitions_.begin())
@@ -2181,56 +3104,202 @@ time_zone::get_info_impl(local_seconds tp) const
         else
             i.second = {};
     }
+#if USE_INFO_CACHE
+    if (i.result == local_info::unique)
+        store_cached_info(this, i.first);
+#endif
     return i;
+#endif  // !(USE_INFO_CACHE && HAS_STRING_VIEW)
 }
 
-std::ostream&
-operator<<(std::ostream& os, const time_zone& z)
+#if HAS_STRING_VIEW
+
+sys_info_view
+time_zone::load_sys_info_view(std::vector<detail::transition>::const_iterator i) const
 {
     using namespace std::chrono;
-    z.init();
-    os << z.name_ << '\n';
-    os << "Initially:           ";
-    auto const& t = z.transitions_.front();
-    if (t.info->offset >= seconds{0})
-        os << '+';
-    os << make_time(t.info->offset);
-    if (t.info->is_dst > 0)
-        os << " daylight ";
+    assert(!transitions_.empty());
+    assert(i != transitions_.begin());
+    sys_info_view r;
+    r.begin = i[-1].timepoint;
+    if (i != transitions_.end())
+        r.end = i->timepoint;
+    else if (footer_)
+        r.end = find_footer_period(*footer_, r.begin, r.begin).end;
     else
-        os << " standard ";
-    os << t.info->abbrev << '\n';
-    for (auto i = std::next(z.transitions_.cbegin()); i < z.transitions_.cend(); ++i)
-        os << *i << '\n';
-    return os;
+        r.end = sys_days(year::max()/max_day);
+    r.offset = i[-1].info->offset;
+    r.save = i[-1].info->is_dst ? minutes{1} : minutes{0};
+    r.abbrev = i[-1].info->abbrev;
+    return r;
 }
 
-#if !MISSING_LEAP_SECONDS
-
-leap::leap(const sys_seconds& s, detail::undocumented)
-    : date_(s)
+sys_info_view
+time_zone::load_footer_info_view(sys_seconds tp) const
 {
+    using namespace std::chrono;
+    auto p = find_footer_period(*footer_, tp, transitions_.back().timepoint);
+    sys_info_view r;
+    r.begin = p.begin;
+    r.end = p.end;
+    r.offset = p.info->offset;
+    r.save = p.info->is_dst ? minutes{1} : minutes{0};
+    r.abbrev = p.info->abbrev;
+    return r;
 }
 
-#endif  // !MISSING_LEAP_SECONDS
-
-#else  // !USE_OS_TZDB
+sys_info_view
+time_zone::get_info_view_impl(sys_seconds tp) const
+{
+    using namespace std;
+#if USE_INFO_CACHE
+    sys_info_view r;
+    if (find_cached_info(this, tp, r))
+        return r;
+#endif
+    init();
+    auto i = find_transition(tp);
+#if USE_INFO_CACHE
+    r = i == transitions_.end() && footer_ ? load_footer_info_view(tp)
+                                           : load_sys_info_view(i);
+    store_cached_info(this, r);
+    return r;
+#else
+    if (i == transitions_.end() && footer_)
+        return load_footer_info_view(tp);
+    return load_sys_info_view(i);
+#endif
+}
+
+// pos is the index of the transition that ends the period, or transitions_.size()
+// once past the last one.
+
+sys_info_view
+time_zone::first_info_view(sys_seconds tp, std::size_t& pos) const
+{
+    init();
+    auto i = find_transition(tp);
+    pos = static_cast<std::size_t>(i - transitions_.begin());
+    if (i == transitions_.end() && footer_)
+        return load_footer_info_view(tp);
+    return load_sys_info_view(i);
+}
+
+sys_info_view
+time_zone::next_info_view(const sys_info_view& i, std::size_t& pos) const
+{
+    if (pos < transitions_.size())
+        return load_sys_info_view(transitions_.begin() + static_cast<std::ptrdiff_t>(++pos));
+    if (!footer_)
+        return i;
+    return load_footer_info_view(i.end);
+}
+
+local_info_view
+time_zone::get_info_view_impl(local_seconds tp) const
+{
+    using namespace std::chrono;
+    local_info_view i{};
+#if USE_INFO_CACHE
+    if (find_cached_info(this, tp, i))
+        return i;
+#endif
+    init();
+    auto tr = find_transition(tp);
+    if (tr == transitions_.end() && footer_)
+    {
+        i = local_info_from_sys<local_info_view>(tp,
+                [this](sys_seconds t) {return get_info_view_impl(t);});
+#if USE_INFO_CACHE
+        if (i.result == local_info_view::unique)
+            store_cached_info(this, i.first);
+#endif
+        return i;
+    }
+    i.result = local_info_view::unique;
+    i.first = load_sys_info_view(tr);
+    auto tps = sys_seconds{(tp - i.first.offset).time_since_epoch()};
+    if (tps < i.first.begin + days{1} && tr != transitions_.begin())
+    {
+        i.second = load_sys_info_view(--tr);
+        tps = sys_seconds{(tp - i.second.offset).time_since_epoch()};
+        if (tps < i.second.end)
+        {
+           i.result = local_info_view::ambiguous;
+           std::swap(i.first, i.second);
+        }
+        else
+        {
+            i.second = {};
+        }
+    }
+    else if (tps >= i.first.end && tr != transitions_.end())
+    {
+        i.second = load_sys_info_view(++tr);
+        tps = sys_seconds{(tp - i.second.offset).time_since_epoch()};
+        if (tps < i.second.begin)
+            i.result = local_info_view::nonexistent;
+        else
+            i.second = {};
+    }
+#if USE_INFO_CACHE
+    if (i.result == local_info_view::unique)
+        store_cached_info(this, i.first);
+#endif
+    return i;
+}
+
+#endif  // HAS_STRING_VIEW
+
+std::ostream&
+operator<<(std::ostream& os, const time_zone& z)
+{
+    using namespace std::chrono;
+    z.init();
+    os << z.name_ << '\n';
+    os << "Initially:           ";
+    auto const& t = z.transitions_.front();
+    if (t.info->offset >= seconds{0})
+        os << '+';
+    os << make_time(t.info->offset);
+    if (t.info->is_dst > 0)
+        os << " daylight ";
+    else
+        os << " standard ";
+    os << t.info->abbrev << '\n';
+    for (auto i = std::next(z.transitions_.cbegin()); i < z.transitions_.cend(); ++i)
+        os << *i << '\n';
+    return os;
+}
+
+#if !MISSING_LEAP_SECONDS
+
+leap::leap(const sys_seconds& s, detail::undocumented)
+    : date_(s)
+{
+}
+
+#endif  // !MISSING_LEAP_SECONDS
+
+#else  // !USE_OS_TZDB
 
 time_zone::time_zone(const std::string& s, detail::undocumented)
-    : adjusted_(new std::once_flag{})
+    : time_zone(detail::line_reader(s), detail::undocumented{})
+{
+}
+
+time_zone::time_zone(detail::line_reader in, detail::undocumented)
+    : adjusted_(new detail::zone_state)
 {
     try
     {
-        using namespace date;
-        std::istringstream in(s);
-        in.exceptions(std::ios::failbit | std::ios::badbit);
-        std::string word;
-        in >> word >> name_;
+        in.read_word();
+        name_ = in.read_word();
         parse_info(in);
     }
     catch (...)
     {
-        std::cerr << s << '\n';
+        std::cerr << in.str() << '\n';
         std::cerr << *this << '\n';
         zonelets_.pop_back();
         throw;
@@ -2240,14 +3309,33 @@ time_zone::time_zone(const std::string& s, detail::undocumented)
 sys_info
 time_zone::get_info_impl(sys_seconds tp) const
 {
+#if USE_INFO_CACHE && HAS_STRING_VIEW
+    // The cache holds views.
+    return to_sys_info(get_info_view_impl(tp));
+#elif USE_INFO_CACHE
+    sys_info r;
+    if (find_cached_info(this, tp, r))
+        return r;
+    r = get_info_impl(tp, static_cast<int>(tz::utc));
+    store_cached_info(this, r);
+    return r;
+#else
     return get_info_impl(tp, static_cast<int>(tz::utc));
+#endif
 }
 
 local_info
 time_zone::get_info_impl(local_seconds tp) const
 {
     using namespace std::chrono;
+#if USE_INFO_CACHE && HAS_STRING_VIEW
+    return to_local_info(get_info_view_impl(tp));
+#else  // !(USE_INFO_CACHE && HAS_STRING_VIEW)
     local_info i{};
+#if USE_INFO_CACHE
+    if (find_cached_info(this, tp, i))
+        return i;
+#endif
     i.first = get_info_impl(sys_seconds{tp.time_since_epoch()}, static_cast<int>(tz::local));
     auto tps = sys_seconds{(tp - i.first.offset).time_since_epoch()};
     if (tps < i.first.begin)
@@ -2265,23 +3353,85 @@ time_zone::get_info_impl(local_seconds tp) const
         else
             i.second = {};
     }
+#if USE_INFO_CACHE
+    if (i.result == local_info::unique)
+        store_cached_info(this, i.first);
+#endif
+    return i;
+#endif  // !(USE_INFO_CACHE && HAS_STRING_VIEW)
+}
+
+#if HAS_STRING_VIEW
+
+sys_info_view
+time_zone::get_info_view_impl(sys_seconds tp) const
+{
+#if USE_INFO_CACHE
+    sys_info_view r;
+    if (find_cached_info(this, tp, r))
+        return r;
+    r = get_info_view_impl(tp, static_cast<int>(tz::utc));
+    store_cached_info(this, r);
+    return r;
+#else
+    return get_info_view_impl(tp, static_cast<int>(tz::utc));
+#endif
+}
+
+local_info_view
+time_zone::get_info_view_impl(local_seconds tp) const
+{
+    using namespace std::chrono;
+    local_info_view i{};
+#if USE_INFO_CACHE
+    if (find_cached_info(this, tp, i))
+        return i;
+#endif
+    i.first = get_info_view_impl(sys_seconds{tp.time_since_epoch()},
+                                 static_cast<int>(tz::local));
+    auto tps = sys_seconds{(tp - i.first.offset).time_since_epoch()};
+    if (tps < i.first.begin)
+    {
+        i.second = i.first;
+        i.first = get_info_view_impl(i.second.begin - seconds{1}, static_cast<int>(tz::utc));
+        i.result = local_info_view::nonexistent;
+    }
+    else if (i.first.end - tps <= days{1})
+    {
+        i.second = get_info_view_impl(i.first.end, static_cast<int>(tz::utc));
+        tps = sys_seconds{(tp - i.second.offset).time_since_epoch()};
+        if (tps >= i.second.begin)
+            i.result = local_info_view::ambiguous;
+        else
+            i.second = {};
+    }
+#if USE_INFO_CACHE
+    if (i.result == local_info_view::unique)
+        store_cached_info(this, i.first);
+#endif
     return i;
 }
 
+#endif  // HAS_STRING_VIEW
+
 void
 time_zone::add(const std::string& s)
+{
+    add(detail::line_reader(s));
+}
+
+void
+time_zone::add(detail::line_reader in)
 {
     try
     {
-        std::istringstream in(s);
-        in.exceptions(std::ios::failbit | std::ios::badbit);
-        ws(in);
+        in.ws();
         if (!in.eof() && in.peek() != '#')
             parse_info(in);
     }
     catch (...)
     {
-        std::cerr << s << '\n';
+        std::cerr << in.str() << '\n';
         std::cerr << *this << '\n';
         zonelets_.pop_back();
         throw;
@@ -2289,19 +3439,18 @@ time_zone::add(const std::string& s)
 }
 
 void
-time_zone::parse_info(std::istream& in)
+time_zone::parse_info(detail::line_reader& in)
 {
     using namespace date;
     using namespace std::chrono;
     zonelets_.emplace_back();
     auto& zonelet = zonelets_.back();
     zonelet.gmtoff_ = parse_signed_time(in);
-    in >> zonelet.u.rule_;
+    zonelet.u.rule_ = in.read_word();
     if (zonelet.u.rule_ == "-")
         zonelet.u.rule_.clear();
-    in >> zonelet.format_;
-    if (!in.eof())
-        ws(in);
+    zonelet.format_ = in.read_word();
+    in.ws();
     if (in.eof() || in.peek() == '#')
     {
         zonelet.until_year_ = year::max();
@@ -2309,9 +3458,7 @@ time_zone::parse_info(std::istream& in)
     }
     else
     {
-        int y;
-        in >> y;
-        zonelet.until_year_ = year{y};
+        zonelet.until_year_ = year{in.read_int()};
         in >> zonelet.until_date_;
         zonelet.until_date_.canonicalize(zonelet.until_year_);
     }
@@ -2329,8 +3476,6 @@ time_zone::adjust_infos(const std::vector<Rule>& rules)
     for (auto& z : zonelets_)
     {
         std::pair<const Rule*, const Rule*> eqr{};
-        std::istringstream in;
-        in.exceptions(std::ios::failbit | std::ios::badbit);
         // Classify info as rule-based, has save, or neither
         if (!z.u.rule_.empty())
         {
@@ -2343,7 +3488,7 @@ time_zone::adjust_infos(const std::vector<Rule>& rules)
                 {
                     using namespace std::chrono;
                     using string = std::string;
-                    in.str(z.u.rule_);
+                    detail::line_reader in(z.u.rule_);
                     auto tmp = duration_cast<minutes>(parse_signed_time(in));
 #if !defined(_MSC_VER) || (_MSC_VER >= 1900)
                     z.u.rule_.~string();
@@ -2433,81 +3578,297 @@ time_zone::adjust_infos(const std::vector<Rule>& rules)
 
 static
 std::string
-format_abbrev(std::string format, const std::string& variable, std::chrono::seconds off,
-                                                               std::chrono::minutes save)
+format_abbrev(const std::string& format, const std::string& variable,
+              std::chrono::seconds off, std::chrono::minutes save)
 {
     using namespace std::chrono;
     auto k = format.find("%s");
     if (k != std::string::npos)
     {
-        format.replace(k, 2, variable);
+        std::string r;
+        r.reserve(format.size() - 2 + variable.size());
+        r.append(format, 0, k).append(variable).append(format, k+2, std::string::npos);
+        return r;
     }
-    else
+    auto j = format.find('/');
+    if (j != std::string::npos)
+        return save == minutes{0} ? format.substr(0, j) : format.substr(j+1);
+    k = format.find("%z");
+    if (k != std::string::npos)
     {
-        k = format.find('/');
-        if (k != std::string::npos)
+        std::string r(format, 0, k);
+        if (off < seconds{0})
         {
-            if (save == minutes{0})
-                format.erase(k);
-            else
-                format.erase(0, k+1);
+            r += '-';
+            off = -off;
         }
         else
+            r += '+';
+        auto h = date::floor<hours>(off);
+        off -= h;
+        if (h < hours{10})
+            r += '0';
+        r += std::to_string(h.count());
+        if (off > seconds{0})
         {
-            k = format.find("%z");
-            if (k != std::string::npos)
+            auto m = date::floor<minutes>(off);
+            off -= m;
+            if (m < minutes{10})
+                r += '0';
+            r += std::to_string(m.count());
+            if (off > seconds{0})
             {
-                std::string temp;
-                if (off < seconds{0})
-                {
-                    temp = '-';
-                    off = -off;
-                }
-                else
-                    temp = '+';
-                auto h = date::floor<hours>(off);
-                off -= h;
-                if (h < hours{10})
-                    temp += '0';
-                temp += std::to_string(h.count());
-                if (off > seconds{0})
-                {
-                    auto m = date::floor<minutes>(off);
-                    off -= m;
-                    if (m < minutes{10})
-                        temp += '0';
-                    temp += std::to_string(m.count());
-                    if (off > seconds{0})
-                    {
-                        if (off < seconds{10})
-                            temp += '0';
-                        temp += std::to_string(off.count());
-                    }
-                }
-                format.replace(k, 2, temp);
+                if (off < seconds{10})
+                    r += '0';
+                r += std::to_string(off.count());
             }
         }
+        r.append(format, k+2, std::string::npos);
+        return r;
     }
     return format;
 }
 
-sys_info
-time_zone::get_info_impl(sys_seconds tp, int tz_int) const
+#if TZDB_SNAPSHOT
+
+class snapshot_reader;
+
+namespace detail
+{
+
+struct snapshot
+{
+    static std::string file(const std::string& install);
+    static std::string stamp(const std::string& path);
+    static bool load(const std::string& file, const std::string& stamp, tzdb& db);
+    static void save(const std::string& file, const std::string& stamp, const tzdb& db);
+    static void write(const std::string& path, const std::string& file,
+                      const std::string& stamp, const std::string& version);
+    static void get_zone(time_zone& z);
+
+private:
+    static void put_header(std::string& buf, const std::string& version,
+                           const std::string& stamp);
+    static void put(std::string& buf, const MonthDayTime& x);
+    static void put(std::string& buf, const Rule& x);
+    static void put(std::string& buf, const zonelet& x, const std::vector<Rule>& rules);
+    static void put(std::string& buf, const sys_info& x);
+
+    static void get(snapshot_reader& in, MonthDayTime& x);
+    static void get(snapshot_reader& in, Rule& x);
+    static void get(snapshot_reader& in, zonelet& x, const std::vector<Rule>& rules);
+    static void get(snapshot_reader& in, sys_info& x);
+};
+
+}  // namespace detail
+
+#endif  // TZDB_SNAPSHOT
+
+void
+time_zone::init() const
+{
+    std::call_once(adjusted_->once,
+                   [this]()
+                   {
+                       auto self = const_cast<time_zone*>(this);
+                       assert(rules_ != nullptr);
+                       auto const& rules = *rules_;
+#if TZDB_SNAPSHOT
+                       if (snapshot_first_ != nullptr)
+                           detail::snapshot::get_zone(*self);
+                       else
+#endif
+                       {
+                           self->adjust_infos(rules);
+                           self->compile_infos(rules);
+                       }
+#if HAS_STRING_VIEW
+                       self->collect_abbrevs(rules);
+#endif
+                       adjusted_->done.store(true, std::memory_order_release);
+                   });
+}
+
+void
+time_zone::compile_infos(const std::vector<Rule>& rules)
 {
     using namespace std::chrono;
     using namespace date;
-    tz timezone = static_cast<tz>(tz_int);
-    assert(timezone != tz::standard);
+    if (zonelets_.empty() || compiled_first_year > compiled_last_year)
+        return;
+    auto tp = sys_seconds{sys_days(compiled_first_year/min_day)};
+    auto const last = sys_seconds{sys_days(compiled_last_year/max_day)};
+    do
+    {
+        compiled_.push_back(walk_rules(tp, static_cast<int>(tz::utc), rules));
+        tp = compiled_.back().end;
+    } while (tp <= last);
+    compiled_.shrink_to_fit();
+}
+
+static
+void
+check_year_range(sys_seconds tp)
+{
+    using namespace date;
     auto y = year_month_day(floor<days>(tp)).year();
     if (y < min_year || y > max_year)
         throw std::runtime_error("The year " + std::to_string(static_cast<int>(y)) +
             " is out of range:[" + std::to_string(static_cast<int>(min_year)) + ", "
                                  + std::to_string(static_cast<int>(max_year)) + "]");
-    std::call_once(*adjusted_,
-                   [this]()
-                   {
-                       const_cast<time_zone*>(this)->adjust_infos(get_tzdb().rules);
-                   });
+}
+
+// Returns the entry of the compiled table holding tp, or nullptr if tp is not
+// covered by the table.
+static
+const sys_info*
+find_compiled_info(const std::vector<sys_info>& compiled, sys_seconds tp, tz timezone)
+{
+    using namespace std::chrono;
+    if (compiled.empty())
+        return nullptr;
+    if (timezone == tz::utc)
+    {
+        if (compiled.front().begin <= tp && tp < compiled.back().end)
+            return &std::upper_bound(compiled.begin(), compiled.end(), tp,
+                                     [](const sys_seconds& x, const sys_info& i)
+                                     {
+                                         return x < i.begin;
+                                     })[-1];
+    }
+    // tp is local.  Stay a day inside the table so that the search can't be
+    // fooled by an offset from outside of it.
+    else if (compiled.front().begin + days{1} <= tp && tp < compiled.back().end - days{1})
+    {
+        return &*std::upper_bound(compiled.begin(), compiled.end(), tp,
+                                  [](const sys_seconds& x, const sys_info& i)
+                                  {
+                                      return x < i.end + i.offset;
+                                  });
+    }
+    return nullptr;
+}
+
+sys_info
+time_zone::get_info_impl(sys_seconds tp, int tz_int) const
+{
+    tz timezone = static_cast<tz>(tz_int);
+    assert(timezone != tz::standard);
+    check_year_range(tp);
+    init();
+    if (auto i = find_compiled_info(compiled_, tp, timezone))
+        return *i;
+    return walk_rules(tp, tz_int, *rules_);
+}
+
+#if HAS_STRING_VIEW
+
+void
+time_zone::collect_abbrevs(const std::vector<Rule>& rules)
+{
+    using namespace std::chrono;
+    abbrevs_.assign(1, std::string{});
+    for (auto const& z : zonelets_)
+    {
+        switch (z.tag_)
+        {
+        case zonelet::has_save:
+            abbrevs_.push_back(format_abbrev(z.format_, "", z.gmtoff_ + z.u.save_,
+                                             z.u.save_));
+            break;
+        case zonelet::is_empty:
+            abbrevs_.push_back(format_abbrev(z.format_, "", z.gmtoff_, minutes{0}));
+            break;
+        case zonelet::has_rule:
+        {
+            // find_rule takes the letters and the save from the rules of this name,
+            // or from initial_abbrev_ and initial_save_.
+            auto eqr = std::equal_range(rules.data(), rules.data() + rules.size(),
+                                        z.u.rule_);
+            std::vector<std::string> letters{z.initial_abbrev_};
+            std::vector<minutes> saves{minutes{0}, z.initial_save_};
+            for (auto r = eqr.first; r != eqr.second; ++r)
+            {
+                letters.push_back(r->abbrev());
+                saves.push_back(r->save());
+            }
+            // A rule set repeats a few letters and saves over many years.
+            std::sort(letters.begin(), letters.end());
+            letters.erase(std::unique(letters.begin(), letters.end()), letters.end());
+            std::sort(saves.begin(), saves.end());
+            saves.erase(std::unique(saves.begin(), saves.end()), saves.end());
+            for (auto const& l : letters)
+                for (auto save : saves)
+                    abbrevs_.push_back(format_abbrev(z.format_, l, z.gmtoff_ + save,
+                                                     save));
+            break;
+        }
+        }
+    }
+    std::sort(abbrevs_.begin(), abbrevs_.end());
+    abbrevs_.erase(std::unique(abbrevs_.begin(), abbrevs_.end()), abbrevs_.end());
+    abbrevs_.shrink_to_fit();
+}
+
+std::string_view
+time_zone::find_abbrev(const std::string& abbrev) const
+{
+    auto i = std::lower_bound(abbrevs_.begin(), abbrevs_.end(), abbrev);
+    if (i == abbrevs_.end() || *i != abbrev)
+        throw std::runtime_error("Abbreviation " + abbrev + " not found for " + name_);
+    return *i;
+}
+
+sys_info_view
+time_zone::get_info_view_impl(sys_seconds tp, int tz_int) const
+{
+    tz timezone = static_cast<tz>(tz_int);
+    assert(timezone != tz::standard);
+    check_year_range(tp);
+    init();
+    if (auto i = find_compiled_info(compiled_, tp, timezone))
+        return {i->begin, i->end, i->offset, i->save, i->abbrev};
+    auto i = walk_rules(tp, tz_int, *rules_);
+    return {i.begin, i.end, i.offset, i.save, find_abbrev(i.abbrev)};
+}
+
+// pos is the index of the period in compiled_, or compiled_.size() if it isn't there.
+
+sys_info_view
+time_zone::first_info_view(sys_seconds tp, std::size_t& pos) const
+{
+    check_year_range(tp);
+    init();
+    if (auto i = find_compiled_info(compiled_, tp, tz::utc))
+    {
+        pos = static_cast<std::size_t>(i - compiled_.data());
+        return {i->begin, i->end, i->offset, i->save, i->abbrev};
+    }
+    pos = compiled_.size();
+    auto i = walk_rules(tp, static_cast<int>(tz::utc), *rules_);
+    return {i.begin, i.end, i.offset, i.save, find_abbrev(i.abbrev)};
+}
+
+sys_info_view
+time_zone::next_info_view(const sys_info_view& i, std::size_t& pos) const
+{
+    if (pos + 1 < compiled_.size() && compiled_[pos + 1].begin == i.end)
+    {
+        auto const& n = compiled_[++pos];
+        return {n.begin, n.end, n.offset, n.save, n.abbrev};
+    }
+    return first_info_view(i.end, pos);
+}
+
+#endif  // HAS_STRING_VIEW
+
+sys_info
+time_zone::walk_rules(sys_seconds tp, int tz_int, const std::vector<Rule>& rules) const
+{
+    using namespace std::chrono;
+    using namespace date;
+    tz timezone = static_cast<tz>(tz_int);
+    auto y = year_month_day(floor<days>(tp)).year();
     auto i = std::upper_bound(zonelets_.begin(), zonelets_.end(), tp,
         [timezone](sys_seconds t, const zonelet& zl)
         {
@@ -2539,7 +3900,7 @@ time_zone::get_info_impl(sys_seconds tp, int tz_int) const
         }
         else
         {
-            r = find_rule(i->first_rule_, i->last_rule_, y, i->gmtoff_,
+            r = find_rule(rules, i->first_rule_, i->last_rule_, y, i->gmtoff_,
                           MonthDayTime(local_seconds{tp.time_since_epoch()}, timezone),
                           i->initial_save_, i->initial_abbrev_);
             r.offset = i->gmtoff_ + r.save;
@@ -2562,11 +3923,7 @@ operator<<(std::ostream& os, const time_zone& z)
     detail::save_ostream<char> _(os);
     os.fill(' ');
     os.flags(std::ios::dec | std::ios::left);
-    std::call_once(*z.adjusted_,
-                   [&z]()
-                   {
-                       const_cast<time_zone&>(z).adjust_infos(get_tzdb().rules);
-                   });
+    z.init();
     os.width(35);
     os << z.name_;
     std::string indent;
@@ -2610,18 +3967,78 @@ operator<<(std::ostream& os, const time_zone& z)
 
 #endif  // !USE_OS_TZDB
 
-#if !MISSING_LEAP_SECONDS
-
-std::ostream&
-operator<<(std::ostream& os, const leap& x)
+void
+time_zone::get_offsets_impl(const sys_seconds* first, const sys_seconds* last,
+                            std::chrono::seconds* result) const
 {
-    using namespace date;
-    return os << x.date_ << "  +";
+    using namespace std::chrono;
+    // [begin, end) is the last period looked up, initially empty
+    sys_seconds begin{};
+    sys_seconds end{};
+    seconds offset{0};
+    for (; first != last; ++first, ++result)
+    {
+        if (!(begin <= *first && *first < end))
+        {
+#if HAS_STRING_VIEW
+            auto i = get_info_view_impl(*first);
+#else
+            auto i = get_info_impl(*first);
+#endif
+            begin = i.begin;
+            end = i.end;
+            offset = i.offset;
+        }
+        *result = offset;
+    }
 }
 
-#endif  // !MISSING_LEAP_SECONDS
-
-#if USE_OS_TZDB
+void
+time_zone::get_offsets_impl(const local_seconds* first, const local_seconds* last,
+                            std::chrono::seconds* result) const
+{
+    using namespace std::chrono;
+    sys_seconds begin{};
+    sys_seconds end{};
+    seconds offset{0};
+    for (; first != last; ++first, ++result)
+    {
+        // A local time more than a day from either end of the last period found
+        // is unique within it.
+        auto tps = sys_seconds{(*first - offset).time_since_epoch()};
+        if (!(begin + days{1} <= tps && tps < end - days{1}))
+        {
+#if HAS_STRING_VIEW
+            auto i = get_info_view_impl(*first);
+            if (i.result != local_info_view::unique)
+#else
+            auto i = get_info_impl(*first);
+            if (i.result != local_info::unique)
+#endif
+            {
+                *result = seconds::min();
+                continue;
+            }
+            begin = i.first.begin;
+            end = i.first.end;
+            offset = i.first.offset;
+        }
+        *result = offset;
+    }
+}
+
+#if !MISSING_LEAP_SECONDS
+
+std::ostream&
+operator<<(std::ostream& os, const leap& x)
+{
+    using namespace date;
+    return os << x.date_ << "  +";
+}
+
+#endif  // !MISSING_LEAP_SECONDS
+
+#if USE_OS_TZDB
 
 # ifdef __APPLE__
 static
@@ -2639,12 +4056,29 @@ get_version()
 }
 # endif
 
+// True for the entries of the zoneinfo directory, at any depth, that aren't zones.
 static
-std::unique_ptr<tzdb>
-init_tzdb()
+bool
+is_ignored_zone_file(const char* name)
+{
+    return name[0]                      == '.'    || // curdir, prevdir, hidden
+           strncmp(name, "posix", 5)    == 0      || // starts with posix
+           strcmp(name, "Factory")      == 0      ||
+           strcmp(name, "iso3166.tab")  == 0      ||
+           strcmp(name, "right")        == 0      ||
+           strcmp(name, "+VERSION")     == 0      ||
+           strcmp(name, "zone.tab")     == 0      ||
+           strcmp(name, "zone1970.tab") == 0      ||
+           strcmp(name, "tzdata.zi")    == 0      ||
+           strcmp(name, "leapseconds")  == 0      ||
+           strcmp(name, "leap-seconds.list") == 0;
+}
+
+// Adds a time_zone to db for every zone file under the zoneinfo directory.
+static
+void
+scan_zone_dir(tzdb& db)
 {
-    std::unique_ptr<tzdb> db(new tzdb);
-
     //Iterate through folders
     std::queue<std::string> subfolders;
     subfolders.emplace(get_tz_dir());
@@ -2659,18 +4093,7 @@ init_tzdb()
             continue;
         while ((d = readdir(dir)) != nullptr)
         {
-            // Ignore these files:
-            if (d->d_name[0]                      == '.'    || // curdir, prevdir, hidden
-                memcmp(d->d_name, "posix", 5)     == 0      || // starts with posix
-                strcmp(d->d_name, "Factory")      == 0      ||
-                strcmp(d->d_name, "iso3166.tab")  == 0      ||
-                strcmp(d->d_name, "right")        == 0      ||
-                strcmp(d->d_name, "+VERSION")     == 0      ||
-                strcmp(d->d_name, "zone.tab")     == 0      ||
-                strcmp(d->d_name, "zone1970.tab") == 0      ||
-                strcmp(d->d_name, "tzdata.zi")    == 0      ||
-                strcmp(d->d_name, "leapseconds")  == 0      ||
-                strcmp(d->d_name, "leap-seconds.list") == 0   )
+            if (is_ignored_zone_file(d->d_name))
                 continue;
             auto subname = dirname + folder_delimiter + d->d_name;
             if(stat(subname.c_str(), &s) == 0)
@@ -2684,37 +4107,167 @@ init_tzdb()
                 }
                 else
                 {
-                    db->zones.emplace_back(subname.substr(get_tz_dir().size()+1),
-                                           detail::undocumented{});
+                    db.zones.emplace_back(subname.substr(get_tz_dir().size()+1),
+                                          detail::undocumented{});
                 }
             }
         }
         closedir(dir);
     }
-    db->zones.shrink_to_fit();
-    std::sort(db->zones.begin(), db->zones.end());
-#  if !MISSING_LEAP_SECONDS
-    std::ifstream in(get_tz_dir() + std::string(1, folder_delimiter) + "right/UTC",
-                     std::ios_base::binary);
-    if (in)
+}
+
+#if USE_TZDATA_ZI
+
+// Adds a time_zone to db for every Zone and Link named in the tzdata.zi file at path,
+// and sets db.version from it.  Returns false if there is no such file.
+static
+bool
+load_zone_names(const std::string& path, tzdb& db)
+{
+    std::string buf;
+    if (!read_file(path, buf))
+        return false;
+    const char* p = buf.data();
+    auto const end = p + buf.size();
+    while (p != end)
     {
-        in.exceptions(std::ios::failbit | std::ios::badbit);
-        db->leaps = load_just_leaps(in);
+        auto first = p;
+        auto last = static_cast<const char*>(std::memchr(p, '\n', end - p));
+        if (last == nullptr)
+            last = end;
+        p = last == end ? end : last + 1;
+        detail::line_reader in(first, last);
+        if (in.eof())
+            continue;
+        auto word = in.read_word();
+        if (word == "Z" || word == "L")
+        {
+            if (word == "L")
+                in.read_word();
+            auto name = in.read_word();
+            // Skipped by scan_zone_dir too
+            if (name != "Factory")
+                db.zones.emplace_back(std::move(name), detail::undocumented{});
+        }
+        else if (word == "#")
+        {
+            in.ws();
+            if (!in.eof() && in.read_word() == "version")
+            {
+                in.ws();
+                if (!in.eof())
+                    db.version = in.read_word();
+            }
+        }
     }
-    else
+    return !db.zones.empty();
+}
+
+// Zone files that tzdata.zi doesn't list, created when locate_zone asks a tzdb for
+// them.  Each tzdb has its own, which are freed along with it.  So after a reload the
+// new tzdb reads them again from the zoneinfo folder, while the zones the old tzdb
+// handed out stay valid for as long as the old tzdb does.
+
+namespace
+{
+
+struct unlisted_zones
+{
+    std::mutex                                   mut;
+    std::map<const tzdb*, std::deque<time_zone>> zones;
+};
+
+}  // unnamed namespace
+
+// Never destroyed, since tzdbs may be deleted during static destruction.
+static
+unlisted_zones&
+get_unlisted_zones()
+{
+    static auto& u = *new unlisted_zones;
+    return u;
+}
+
+static
+void
+forget_unlisted_zones(const tzdb* db)
+{
+    auto& u = get_unlisted_zones();
+    std::lock_guard<std::mutex> lock(u.mut);
+    u.zones.erase(db);
+}
+
+static
+const time_zone*
+locate_unlisted_zone(const tzdb& db, const std::string& name)
+{
+    // Only names that scan_zone_dir would have found.  Every component is checked, so
+    // this also rejects empty components, ".." and absolute paths.
+    std::string::size_type b = 0;
+    do
+    {
+        auto e = name.find(folder_delimiter, b);
+        auto part = name.substr(b, e == std::string::npos ? e : e - b);
+        if (part.empty() || is_ignored_zone_file(part.c_str()))
+            return nullptr;
+        b = e == std::string::npos ? e : e + 1;
+    } while (b != std::string::npos);
+    auto& u = get_unlisted_zones();
+    std::lock_guard<std::mutex> lock(u.mut);
+    auto& zones = u.zones[&db];
+    for (auto const& z : zones)
     {
-        in.clear();
-        in.open(get_tz_dir() + std::string(1, folder_delimiter) +
-                "UTC", std::ios_base::binary);
-        if (!in)
-            throw std::runtime_error("Unable to extract leap second information");
-        in.exceptions(std::ios::failbit | std::ios::badbit);
-        db->leaps = load_just_leaps(in);
+        if (z.name() == name)
+            return &z;
     }
+    std::string buf;
+    if (!read_file(get_tz_dir() + folder_delimiter + name, buf) ||
+        buf.compare(0, 4, "TZif") != 0)
+        return nullptr;
+    zones.emplace_back(name, detail::undocumented{});
+    return &zones.back();
+}
+
+// True if z has been loaded, or the zoneinfo directory has its file.  tzdata.zi may
+// list zones whose files a distribution has left out.
+static
+bool
+has_zone_file(const time_zone& z)
+{
+    if (z.is_initialized())
+        return true;
+    struct stat s;
+    return stat((get_tz_dir() + folder_delimiter + z.name()).c_str(), &s) == 0 &&
+           !S_ISDIR(s.st_mode);
+}
+
+#endif  // USE_TZDATA_ZI
+
+static
+std::unique_ptr<tzdb>
+init_tzdb()
+{
+    std::unique_ptr<tzdb> db(new tzdb);
+#if USE_TZDATA_ZI
+    if (!load_zone_names(get_tz_dir() + folder_delimiter + "tzdata.zi", *db))
+#endif
+        scan_zone_dir(*db);
+    db->zones.shrink_to_fit();
+    std::sort(db->zones.begin(), db->zones.end());
+#  if !MISSING_LEAP_SECONDS
+    std::string buf;
+    if (!read_file(get_tz_dir() + std::string(1, folder_delimiter) + "right/UTC", buf) &&
+        !read_file(get_tz_dir() + std::string(1, folder_delimiter) + "UTC", buf))
+        throw std::runtime_error("Unable to extract leap second information");
+    db->leaps = load_just_leaps(buf);
 #  endif  // !MISSING_LEAP_SECONDS
 #  ifdef __APPLE__
     db->version = get_version();
 #  endif
+    build_name_index(*db);
+#if !MISSING_LEAP_SECONDS
+    build_leap_index(*db);
+#endif
     return db;
 }
 
@@ -2723,12 +4276,15 @@ init_tzdb()
 // link
 
 link::link(const std::string& s)
+    : link(detail::line_reader(s))
 {
-    using namespace date;
-    std::istringstream in(s);
-    in.exceptions(std::ios::failbit | std::ios::badbit);
-    std::string word;
-    in >> word >> target_ >> name_;
+}
+
+link::link(detail::line_reader in)
+{
+    in.read_word();
+    target_ = in.read_word();
+    name_ = in.read_word();
 }
 
 std::ostream&
@@ -2745,14 +4301,17 @@ operator<<(std::ostream& os, const link& x)
 // leap
 
 leap::leap(const std::string& s, detail::undocumented)
+    : leap(detail::line_reader(s), detail::undocumented{})
+{
+}
+
+leap::leap(detail::line_reader in, detail::undocumented)
 {
     using namespace date;
-    std::istringstream in(s);
-    in.exceptions(std::ios::failbit | std::ios::badbit);
-    std::string word;
-    int y;
+    in.read_word();
+    auto y = in.read_int();
     MonthDayTime date;
-    in >> word >> y >> date;
+    in >> date;
     date_ = date.to_time_point(year(y));
 }
 
@@ -3354,169 +4913,1235 @@ get_version(const std::string& path)
     throw std::runtime_error("Unable to get Timezone database version from " + path);
 }
 
+// Parses one tzdata region file, appending what it finds to db.
 static
-std::unique_ptr<tzdb>
-init_tzdb()
+void
+load_tzdata_file(const std::string& path, tzdb& db)
 {
-    using namespace date;
-    const std::string install = get_install();
-    const std::string path = install + folder_delimiter;
-    std::string line;
+    std::string buf;
+    if (!read_file(path, buf))
+        return;
     bool continue_zone = false;
-    std::unique_ptr<tzdb> db(new tzdb);
-
-#if AUTO_DOWNLOAD
-    if (!file_exists(install))
+    const char* p = buf.data();
+    auto const end = p + buf.size();
+    while (p != end)
     {
-        auto rv = remote_version();
-        if (!rv.empty() && remote_download(rv))
+        auto first = p;
+        auto last = static_cast<const char*>(std::memchr(p, '\n', end - p));
+        if (last == nullptr)
+            last = end;
+        p = last == end ? end : last + 1;
+        if (last != first && last[-1] == '\r')
+            --last;
+        if (first != last && *first != '#')
         {
-            if (!remote_install(rv))
+            detail::line_reader line(first, last);
+            detail::line_reader in = line;
+            in.ws();
+            auto word = in.eof() ? std::string{} : in.read_word();
+            if (word == "Rule")
             {
-                std::string msg = "Timezone database version \"";
-                msg += rv;
-                msg += "\" did not install correctly to \"";
-                msg += install;
-                msg += "\"";
-                throw std::runtime_error(msg);
+                db.rules.push_back(Rule(line));
+                continue_zone = false;
             }
-        }
-        if (!file_exists(install))
-        {
-            std::string msg = "Timezone database not found at \"";
-            msg += install;
-            msg += "\"";
-            throw std::runtime_error(msg);
-        }
-        db->version = get_version(path);
-    }
-    else
-    {
-        db->version = get_version(path);
-        auto rv = remote_version();
-        if (!rv.empty() && db->version != rv)
-        {
-            if (remote_download(rv))
+            else if (word == "Link")
             {
-                remote_install(rv);
-                db->version = get_version(path);
+                db.links.push_back(link(line));
+                continue_zone = false;
+            }
+            else if (word == "Leap")
+            {
+                db.leaps.push_back(leap(line, detail::undocumented{}));
+                continue_zone = false;
+            }
+            else if (word == "Zone")
+            {
+                db.zones.push_back(time_zone(line, detail::undocumented{}));
+                continue_zone = true;
+            }
+            else if (*first == '\t' && continue_zone)
+            {
+                db.zones.back().add(line);
+            }
+            else
+            {
+                std::cerr << line.str() << '\n';
             }
         }
     }
-#else  // !AUTO_DOWNLOAD
-    if (!file_exists(install))
-    {
-        std::string msg = "Timezone database not found at \"";
-        msg += install;
-        msg += "\"";
-        throw std::runtime_error(msg);
-    }
-    db->version = get_version(path);
-#endif  // !AUTO_DOWNLOAD
+}
 
-    CONSTDATA char*const files[] =
-    {
-        "africa", "antarctica", "asia", "australasia", "backward", "etcetera", "europe",
-        "pacificnew", "northamerica", "southamerica", "systemv", "leapseconds"
-    };
+#if PARALLEL_TZDB_LOAD
+
+template <class T>
+static
+void
+move_append(std::vector<T>& to, std::vector<T>& from)
+{
+    to.insert(to.end(), std::make_move_iterator(from.begin()),
+                        std::make_move_iterator(from.end()));
+}
+
+#endif  // PARALLEL_TZDB_LOAD
+
+static CONSTDATA char*const tzdata_files[] =
+{
+    "africa", "antarctica", "asia", "australasia", "backward", "etcetera", "europe",
+    "pacificnew", "northamerica", "southamerica", "systemv", "leapseconds"
+};
 
-    for (const auto& filename : files)
+namespace detail
+{
+
+void
+bind_rules(tzdb& db)
+{
+    for (auto& z : db.zones)
+        z.rules_ = &db.rules;
+}
+
+}  // namespace detail
+
+// Parses the tzdata files in path into db, then sorts everything and splits the
+// overlapping rules.
+static
+void
+parse_tzdata(const std::string& path, tzdb& db)
+{
+#if PARALLEL_TZDB_LOAD
+    CONSTDATA auto nfiles = sizeof(tzdata_files) / sizeof(tzdata_files[0]);
+    std::vector<tzdb> parts(nfiles);
+    parallel_for(nfiles, 0,
+                 [&](std::size_t i)
+                 {
+                     load_tzdata_file(path + tzdata_files[i], parts[i]);
+                 });
+    for (std::size_t i = 0; i < nfiles; ++i)
     {
-        std::ifstream infile(path + filename);
-        while (infile)
-        {
-            std::getline(infile, line);
-            if (!line.empty() && line[0] != '#')
-            {
-                std::istringstream in(line);
-                std::string word;
-                in >> word;
-                if (word == "Rule")
-                {
-                    db->rules.push_back(Rule(line));
-                    continue_zone = false;
-                }
-                else if (word == "Link")
-                {
-                    db->links.push_back(link(line));
-                    continue_zone = false;
-                }
-                else if (word == "Leap")
-                {
-                    db->leaps.push_back(leap(line, detail::undocumented{}));
-                    continue_zone = false;
-                }
-                else if (word == "Zone")
-                {
-                    db->zones.push_back(time_zone(line, detail::undocumented{}));
-                    continue_zone = true;
-                }
-                else if (line[0] == '\t' && continue_zone)
-                {
-                    db->zones.back().add(line);
-                }
-                else
-                {
-                    std::cerr << line << '\n';
-                }
-            }
-        }
+        move_append(db.rules, parts[i].rules);
+        move_append(db.zones, parts[i].zones);
+        move_append(db.links, parts[i].links);
+        move_append(db.leaps, parts[i].leaps);
     }
-    std::sort(db->rules.begin(), db->rules.end());
-    Rule::split_overlaps(db->rules);
-    std::sort(db->zones.begin(), db->zones.end());
-    db->zones.shrink_to_fit();
-    std::sort(db->links.begin(), db->links.end());
-    db->links.shrink_to_fit();
-    std::sort(db->leaps.begin(), db->leaps.end());
-    db->leaps.shrink_to_fit();
-
-#ifdef _WIN32
-    std::string mapping_file = get_install() + folder_delimiter + "windowsZones.xml";
-    db->mappings = load_timezone_mappings_from_xml_file(mapping_file);
-    sort_zone_mappings(db->mappings);
-#endif // _WIN32
+#else  // !PARALLEL_TZDB_LOAD
+    for (const auto& filename : tzdata_files)
+        load_tzdata_file(path + filename, db);
+#endif  // !PARALLEL_TZDB_LOAD
+    std::sort(db.rules.begin(), db.rules.end());
+    Rule::split_overlaps(db.rules);
+    std::sort(db.zones.begin(), db.zones.end());
+    db.zones.shrink_to_fit();
+    std::sort(db.links.begin(), db.links.end());
+    db.links.shrink_to_fit();
+    std::sort(db.leaps.begin(), db.leaps.end());
+    db.leaps.shrink_to_fit();
+}
+
+#if TZDB_SNAPSHOT
+
+// Snapshot file helpers.  Every number is stored as a 64 bit integer in the byte order
+// of the machine that wrote it, and every string as its length followed by its bytes.
+// Places in the file are stored as offsets from its start, so it can be mapped at any
+// address.
 
-    return db;
+static
+void
+put_int(std::string& buf, std::int64_t x)
+{
+    buf.append(reinterpret_cast<const char*>(&x), sizeof(x));
 }
 
-const tzdb&
-reload_tzdb()
+static
+void
+put_string(std::string& buf, const std::string& s)
 {
-#if AUTO_DOWNLOAD
-    auto const& v = get_tzdb_list().front().version;
-    if (!v.empty() && v == remote_version())
-        return get_tzdb_list().front();
-#endif  // AUTO_DOWNLOAD
-    tzdb_list::undocumented_helper::push_front(get_tzdb_list(), init_tzdb().release());
-    return get_tzdb_list().front();
+    put_int(buf, static_cast<std::int64_t>(s.size()));
+    buf += s;
 }
 
-#endif  // !USE_OS_TZDB
+// Overwrites the number at offset i of buf, once what it refers to has been written.
+static
+void
+patch_int(std::string& buf, std::size_t i, std::int64_t x)
+{
+    std::memcpy(&buf[i], &x, sizeof(x));
+}
 
-const tzdb&
-get_tzdb()
+// A 64 bit FNV-1a over the words of [p, p+n).  Each step is a bijection of the hash,
+// so changing any one word always changes the result.
+static
+std::uint64_t
+checksum(const char* p, std::size_t n)
 {
-    return get_tzdb_list().front();
+    std::uint64_t h = 14695981039346656037u;
+    for (; n >= sizeof(std::uint64_t); p += sizeof(std::uint64_t), n -= sizeof(std::uint64_t))
+    {
+        std::uint64_t w;
+        std::memcpy(&w, p, sizeof(w));
+        h = (h ^ w) * 1099511628211u;
+    }
+    for (; n > 0; ++p, --n)
+        h = (h ^ static_cast<unsigned char>(*p)) * 1099511628211u;
+    return h;
 }
 
-const time_zone*
-#if HAS_STRING_VIEW
-tzdb::locate_zone(std::string_view tz_name) const
-#else
-tzdb::locate_zone(const std::string& tz_name) const
-#endif
+class snapshot_reader
 {
-    auto zi = std::lower_bound(zones.begin(), zones.end(), tz_name,
-#if HAS_STRING_VIEW
-        [](const time_zone& z, const std::string_view& nm)
-#else
-        [](const time_zone& z, const std::string& nm)
-#endif
-        {
-            return z.name() < nm;
-        });
-    if (zi == zones.end() || zi->name() != tz_name)
+    const char* p_;
+    const char* last_;
+
+public:
+    snapshot_reader(const char* first, const char* last) : p_(first), last_(last) {}
+
+    bool eof() const {return p_ == last_;}
+    const char* pos() const {return p_;}
+
+    std::int64_t
+    get_int()
+    {
+        std::int64_t x;
+        if (static_cast<std::size_t>(last_ - p_) < sizeof(x))
+            throw std::runtime_error("tzdb snapshot is truncated");
+        std::memcpy(&x, p_, sizeof(x));
+        p_ += sizeof(x);
+        return x;
+    }
+
+    // Reads a length or count, which can not be more than the bytes that are left.
+    std::size_t
+    get_size()
+    {
+        auto n = get_int();
+        if (n < 0 || n > last_ - p_)
+            throw std::runtime_error("tzdb snapshot is corrupt");
+        return static_cast<std::size_t>(n);
+    }
+
+    std::string
+    get_string()
+    {
+        auto n = get_size();
+        std::string s(p_, n);
+        p_ += n;
+        return s;
+    }
+};
+
+// Maps file read only.  The mapping goes away with the last copy of the pointer to its
+// first byte.  Where there is no mmap the file is read into memory instead.  Returns
+// null if the file can't be opened or is empty.
+static
+std::shared_ptr<const char>
+map_file(const std::string& file, std::size_t& size)
+{
+#ifndef _WIN32
+    auto fd = ::open(file.c_str(), O_RDONLY);
+    if (fd == -1)
+        return nullptr;
+    struct stat sb;
+    void* p = MAP_FAILED;
+    if (::fstat(fd, &sb) == 0 && sb.st_size > 0)
+        p = ::mmap(nullptr, static_cast<std::size_t>(sb.st_size), PROT_READ, MAP_SHARED,
+                   fd, 0);
+    ::close(fd);
+    if (p == MAP_FAILED)
+        return nullptr;
+    auto n = size = static_cast<std::size_t>(sb.st_size);
+    return std::shared_ptr<const char>(static_cast<const char*>(p),
+                                       [n](const char* q)
+                                       {
+                                           ::munmap(const_cast<char*>(q), n);
+                                       });
+#else  // _WIN32
+    auto buf = std::make_shared<std::string>();
+    if (!read_file(file, *buf) || buf->empty())
+        return nullptr;
+    size = buf->size();
+    return std::shared_ptr<const char>(buf, buf->data());
+#endif  // _WIN32
+}
+
+namespace detail
+{
+
+// Where the snapshot of the tzdata in install is kept:  in the user's cache folder,
+// since the install folder may be read only or shared, under a name made from install.
+// Empty if there is no cache folder.
+std::string
+snapshot::file(const std::string& install)
+{
+    std::string dir;
+#ifdef _WIN32
+    if (auto local = std::getenv("LOCALAPPDATA"))
+        dir = local;
+#else
+    if (auto cache = std::getenv("XDG_CACHE_HOME"))
+        dir = cache;
+    else if (auto home = std::getenv("HOME"))
+        dir = std::string(home) + "/.cache";
+#endif
+    if (dir.empty())
+        return dir;
+    auto make_dir = [](const std::string& d)
+    {
+#ifdef _WIN32
+        CreateDirectoryA(d.c_str(), nullptr);
+#else
+        ::mkdir(d.c_str(), 0755);
+#endif
+    };
+    make_dir(dir);
+    dir += folder_delimiter;
+    dir += "date";
+    make_dir(dir);
+    // FNV-1a
+    std::uint64_t h = 14695981039346656037u;
+    for (auto c : install)
+    {
+        h ^= static_cast<unsigned char>(c);
+        h *= 1099511628211u;
+    }
+    char name[32];
+    std::snprintf(name, sizeof(name), "tzdb-%016llx.snapshot",
+                  static_cast<unsigned long long>(h));
+    return dir + folder_delimiter + name;
+}
+
+// The size, inode, and modification and status change times of each tzdata file, the
+// times to the nanosecond where the system keeps them.  A rewrite always changes the
+// status change time, even one that keeps the size and sets the modification time
+// back.  A snapshot is only used if it was written for the same stamp.
+std::string
+snapshot::stamp(const std::string& path)
+{
+    std::string r;
+    auto add = [&r](const std::string& filename)
+    {
+        struct stat sb;
+        if (stat(filename.c_str(), &sb) == 0)
+        {
+            put_int(r, static_cast<std::int64_t>(sb.st_size));
+            put_int(r, static_cast<std::int64_t>(sb.st_ino));
+            put_int(r, static_cast<std::int64_t>(sb.st_mtime));
+            put_int(r, static_cast<std::int64_t>(sb.st_ctime));
+#if defined(__APPLE__)
+            put_int(r, static_cast<std::int64_t>(sb.st_mtimespec.tv_nsec));
+            put_int(r, static_cast<std::int64_t>(sb.st_ctimespec.tv_nsec));
+#elif !defined(_WIN32)
+            put_int(r, static_cast<std::int64_t>(sb.st_mtim.tv_nsec));
+            put_int(r, static_cast<std::int64_t>(sb.st_ctim.tv_nsec));
+#endif
+        }
+        else
+            put_int(r, -1);
+    };
+    for (const auto& filename : tzdata_files)
+        add(path + filename);
+    add(path + "version");
+    return r;
+}
+
+// Everything a snapshot depends on besides its contents:  the format, the byte order,
+// the compiled and supported year ranges of this build, and the tzdata it was made from.
+void
+snapshot::put_header(std::string& buf, const std::string& version,
+                     const std::string& stamp)
+{
+    buf.append("TZDBSNAP", 8);
+    put_int(buf, 3);
+    put_int(buf, 0x0102030405060708);
+    put_int(buf, static_cast<int>(compiled_first_year));
+    put_int(buf, static_cast<int>(compiled_last_year));
+    put_int(buf, static_cast<int>(min_year));
+    put_int(buf, static_cast<int>(max_year));
+    put_string(buf, version);
+    put_string(buf, stamp);
+}
+
+void
+snapshot::put(std::string& buf, const MonthDayTime& x)
+{
+    put_int(buf, x.type_);
+    switch (x.type_)
+    {
+    case MonthDayTime::month_day:
+        put_int(buf, static_cast<unsigned>(x.u.month_day_.month()));
+        put_int(buf, static_cast<unsigned>(x.u.month_day_.day()));
+        break;
+    case MonthDayTime::month_last_dow:
+        put_int(buf, static_cast<unsigned>(x.u.month_weekday_last_.month()));
+        put_int(buf, x.u.month_weekday_last_.weekday_last().weekday().c_encoding());
+        break;
+    case MonthDayTime::lteq:
+    case MonthDayTime::gteq:
+        put_int(buf, static_cast<unsigned>(x.u.month_day_weekday_.month_day_.month()));
+        put_int(buf, static_cast<unsigned>(x.u.month_day_weekday_.month_day_.day()));
+        put_int(buf, x.u.month_day_weekday_.weekday_.c_encoding());
+        break;
+    }
+    put_int(buf, x.h_.count());
+    put_int(buf, x.m_.count());
+    put_int(buf, x.s_.count());
+    put_int(buf, static_cast<int>(x.zone_));
+}
+
+void
+snapshot::put(std::string& buf, const Rule& x)
+{
+    put_string(buf, x.name_);
+    put_int(buf, static_cast<int>(x.starting_year_));
+    put_int(buf, static_cast<int>(x.ending_year_));
+    put(buf, x.starting_at_);
+    put_int(buf, x.save_.count());
+    put_string(buf, x.abbrev_);
+}
+
+// A zonelet as adjust_infos leaves it.  Its rules are stored as indices into rules.
+void
+snapshot::put(std::string& buf, const zonelet& x, const std::vector<Rule>& rules)
+{
+    auto rule_index = [&rules](const Rule* r)
+    {
+        return r == nullptr ? std::int64_t{-1} : static_cast<std::int64_t>(r - rules.data());
+    };
+    put_int(buf, x.tag_);
+    put_int(buf, x.gmtoff_.count());
+    if (x.tag_ == zonelet::has_rule)
+        put_string(buf, x.u.rule_);
+    else if (x.tag_ == zonelet::has_save)
+        put_int(buf, x.u.save_.count());
+    put_string(buf, x.format_);
+    put_int(buf, static_cast<int>(x.until_year_));
+    put(buf, x.until_date_);
+    put_int(buf, x.until_utc_.time_since_epoch().count());
+    put_int(buf, x.until_std_.time_since_epoch().count());
+    put_int(buf, x.until_loc_.time_since_epoch().count());
+    put_int(buf, x.initial_save_.count());
+    put_string(buf, x.initial_abbrev_);
+    put_int(buf, rule_index(x.first_rule_.first));
+    put_int(buf, static_cast<int>(x.first_rule_.second));
+    put_int(buf, rule_index(x.last_rule_.first));
+    put_int(buf, static_cast<int>(x.last_rule_.second));
+}
+
+void
+snapshot::put(std::string& buf, const sys_info& x)
+{
+    put_int(buf, x.begin.time_since_epoch().count());
+    put_int(buf, x.end.time_since_epoch().count());
+    put_int(buf, x.offset.count());
+    put_int(buf, x.save.count());
+    put_string(buf, x.abbrev);
+}
+
+// Writes db to file, once every zone in it has been initialized.  The zones are laid
+// out after everything else, each where a table after the zone names says, so that
+// load only has to read as far as that table and a checksum of the zones.  The file
+// is written under a temporary name and renamed into place, so a reader never sees
+// half of one.  Failing to write it is not an error; the text is simply parsed next
+// time.
+void
+snapshot::save(const std::string& file, const std::string& stamp, const tzdb& db)
+{
+    std::string buf;
+    put_header(buf, db.version, stamp);
+    put_int(buf, static_cast<std::int64_t>(db.rules.size()));
+    for (const auto& r : db.rules)
+        put(buf, r);
+    put_int(buf, static_cast<std::int64_t>(db.links.size()));
+    for (const auto& l : db.links)
+    {
+        put_string(buf, l.name_);
+        put_string(buf, l.target_);
+    }
+#if !MISSING_LEAP_SECONDS
+    put_int(buf, static_cast<std::int64_t>(db.leaps.size()));
+    for (const auto& l : db.leaps)
+        put_int(buf, l.date_.time_since_epoch().count());
+#else
+    put_int(buf, 0);
+#endif
+    put_int(buf, static_cast<std::int64_t>(db.zones.size()));
+    std::vector<std::size_t> offsets;
+    offsets.reserve(db.zones.size());
+    for (const auto& z : db.zones)
+    {
+        put_string(buf, z.name_);
+        offsets.push_back(buf.size());
+        put_int(buf, 0);
+        put_int(buf, 0);
+    }
+    auto sum = buf.size();
+    put_int(buf, 0);
+    auto zones_first = buf.size();
+    for (std::size_t i = 0; i < db.zones.size(); ++i)
+    {
+        auto const& z = db.zones[i];
+        assert(z.is_initialized());
+        patch_int(buf, offsets[i], static_cast<std::int64_t>(buf.size()));
+        put_int(buf, static_cast<std::int64_t>(z.zonelets_.size()));
+        for (const auto& zl : z.zonelets_)
+            put(buf, zl, db.rules);
+        put_int(buf, static_cast<std::int64_t>(z.compiled_.size()));
+        for (const auto& info : z.compiled_)
+            put(buf, info);
+        patch_int(buf, offsets[i] + 8, static_cast<std::int64_t>(buf.size()));
+    }
+    patch_int(buf, sum, static_cast<std::int64_t>(checksum(buf.data() + zones_first,
+                                                           buf.size() - zones_first)));
+
+    // Unique to this call, since other threads and processes may be loading the
+    // same tzdata.
+    static std::atomic<unsigned> count{0};
+#ifdef _WIN32
+    auto pid = static_cast<unsigned long>(GetCurrentProcessId());
+#else
+    auto pid = static_cast<long>(::getpid());
+#endif
+    auto tmp = file + '.' + std::to_string(pid) + '.' + std::to_string(count++) + ".tmp";
+    {
+        std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+        if (!out.is_open())
+            return;
+        out.write(buf.data(), static_cast<std::streamsize>(buf.size()));
+        if (!out)
+        {
+            out.close();
+            std::remove(tmp.c_str());
+            return;
+        }
+    }
+#ifdef _WIN32
+    std::remove(file.c_str());
+#endif
+    if (std::rename(tmp.c_str(), file.c_str()) != 0)
+        std::remove(tmp.c_str());
+}
+
+void
+snapshot::get(snapshot_reader& in, MonthDayTime& x)
+{
+    using namespace date;
+    auto month_of = [&in]()
+    {
+        auto m = in.get_int();
+        if (m < 1 || m > 12)
+            throw std::runtime_error("tzdb snapshot is corrupt");
+        return date::month(static_cast<unsigned>(m));
+    };
+    auto day_of = [&in]()
+    {
+        auto d = in.get_int();
+        if (d < 1 || d > 31)
+            throw std::runtime_error("tzdb snapshot is corrupt");
+        return date::day(static_cast<unsigned>(d));
+    };
+    auto weekday_of = [&in]()
+    {
+        auto wd = in.get_int();
+        if (wd < 0 || wd > 6)
+            throw std::runtime_error("tzdb snapshot is corrupt");
+        return weekday(static_cast<unsigned>(wd));
+    };
+    auto type = in.get_int();
+    switch (type)
+    {
+    case MonthDayTime::month_day:
+        {
+            auto m = month_of();
+            x.u = m/day_of();
+            x.type_ = MonthDayTime::month_day;
+        }
+        break;
+    case MonthDayTime::month_last_dow:
+        {
+            auto m = month_of();
+            x.u = m/weekday_of()[last];
+            x.type_ = MonthDayTime::month_last_dow;
+        }
+        break;
+    case MonthDayTime::lteq:
+    case MonthDayTime::gteq:
+        {
+            auto m = month_of();
+            auto d = day_of();
+            x.u = MonthDayTime::pair{m/d, weekday_of()};
+            x.type_ = static_cast<MonthDayTime::Type>(type);
+        }
+        break;
+    default:
+        throw std::runtime_error("tzdb snapshot is corrupt");
+    }
+    x.h_ = std::chrono::hours{in.get_int()};
+    x.m_ = std::chrono::minutes{in.get_int()};
+    x.s_ = std::chrono::seconds{in.get_int()};
+    auto zone = in.get_int();
+    if (zone < static_cast<int>(tz::utc) || zone > static_cast<int>(tz::standard))
+        throw std::runtime_error("tzdb snapshot is corrupt");
+    x.zone_ = static_cast<tz>(zone);
+}
+
+void
+snapshot::get(snapshot_reader& in, Rule& x)
+{
+    x.name_ = in.get_string();
+    x.starting_year_ = date::year{static_cast<int>(in.get_int())};
+    x.ending_year_ = date::year{static_cast<int>(in.get_int())};
+    get(in, x.starting_at_);
+    x.save_ = std::chrono::minutes{in.get_int()};
+    x.abbrev_ = in.get_string();
+}
+
+
+void
+snapshot::get(snapshot_reader& in, zonelet& x, const std::vector<Rule>& rules)
+{
+    using namespace std::chrono;
+    auto rule_at = [&in, &rules]() -> const Rule*
+    {
+        auto i = in.get_int();
+        if (i < -1 || i >= static_cast<std::int64_t>(rules.size()))
+            throw std::runtime_error("tzdb snapshot is corrupt");
+        return i == -1 ? nullptr : rules.data() + i;
+    };
+    auto tag = in.get_int();
+    x.gmtoff_ = seconds{in.get_int()};
+    switch (tag)
+    {
+    case zonelet::has_rule:
+        x.u.rule_ = in.get_string();
+        break;
+    case zonelet::has_save:
+        {
+            auto save = minutes{in.get_int()};
+#if !defined(_MSC_VER) || (_MSC_VER >= 1900)
+            using string = std::string;
+            x.u.rule_.~string();
+            x.tag_ = zonelet::has_save;
+            ::new(&x.u.save_) minutes(save);
+#else
+            x.tag_ = zonelet::has_save;
+            x.u.save_ = save;
+#endif
+        }
+        break;
+    case zonelet::is_empty:
+        x.tag_ = zonelet::is_empty;
+        break;
+    default:
+        throw std::runtime_error("tzdb snapshot is corrupt");
+    }
+    x.format_ = in.get_string();
+    x.until_year_ = date::year{static_cast<int>(in.get_int())};
+    get(in, x.until_date_);
+    x.until_utc_ = sys_seconds{seconds{in.get_int()}};
+    x.until_std_ = local_seconds{seconds{in.get_int()}};
+    x.until_loc_ = local_seconds{seconds{in.get_int()}};
+    x.initial_save_ = minutes{in.get_int()};
+    x.initial_abbrev_ = in.get_string();
+    x.first_rule_.first = rule_at();
+    x.first_rule_.second = date::year{static_cast<int>(in.get_int())};
+    x.last_rule_.first = rule_at();
+    x.last_rule_.second = date::year{static_cast<int>(in.get_int())};
+}
+
+void
+snapshot::get(snapshot_reader& in, sys_info& x)
+{
+    using namespace std::chrono;
+    x.begin = sys_seconds{seconds{in.get_int()}};
+    x.end = sys_seconds{seconds{in.get_int()}};
+    x.offset = seconds{in.get_int()};
+    x.save = minutes{in.get_int()};
+    x.abbrev = in.get_string();
+}
+
+// Decodes the adjusted zonelets and the compiled table of z from the snapshot that it
+// was loaded from, in place of adjust_infos and compile_infos.  load has checked the
+// bytes against the checksum that save, in a build with the same configuration, wrote
+// for them, so they always decode.
+void
+snapshot::get_zone(time_zone& z)
+{
+    snapshot_reader in(z.snapshot_first_, z.snapshot_last_);
+    std::vector<zonelet> zonelets(in.get_size());
+    for (auto& zl : zonelets)
+        get(in, zl, *z.rules_);
+    std::vector<sys_info> compiled(in.get_size());
+    for (auto& i : compiled)
+        get(in, i);
+    assert(in.eof());
+    z.zonelets_ = std::move(zonelets);
+    z.compiled_ = std::move(compiled);
+}
+
+// Fills db from file if it is a snapshot of the tzdata with this stamp, made by a build
+// with the same configuration.  Returns false, leaving db alone, if it is not, or if
+// the zones in it don't match their checksum.  The file is mapped, and only its rules,
+// links, leaps and zone names are read here.  Each zone reads the rest of its own data
+// from the mapping when it is first used.
+bool
+snapshot::load(const std::string& file, const std::string& stamp, tzdb& db)
+{
+    std::size_t size = 0;
+    auto data = map_file(file, size);
+    if (data == nullptr)
+        return false;
+    const char* first = data.get();
+    std::string header;
+    put_header(header, db.version, stamp);
+    if (size < header.size() || std::memcmp(first, header.data(), header.size()) != 0)
+        return false;
+    tzdb tmp;
+    try
+    {
+        snapshot_reader in(first + header.size(), first + size);
+        tmp.rules.resize(in.get_size());
+        for (auto& r : tmp.rules)
+            get(in, r);
+        auto nlinks = in.get_size();
+        tmp.links.reserve(nlinks);
+        for (std::size_t i = 0; i < nlinks; ++i)
+        {
+            link l;
+            l.name_ = in.get_string();
+            l.target_ = in.get_string();
+            tmp.links.push_back(std::move(l));
+        }
+        auto nleaps = in.get_size();
+#if !MISSING_LEAP_SECONDS
+        tmp.leaps.reserve(nleaps);
+        for (std::size_t i = 0; i < nleaps; ++i)
+        {
+            leap l;
+            l.date_ = sys_seconds{std::chrono::seconds{in.get_int()}};
+            tmp.leaps.push_back(l);
+        }
+#else
+        if (nleaps != 0)
+            return false;
+#endif
+        auto nzones = in.get_size();
+        tmp.zones.reserve(nzones);
+        std::vector<std::pair<std::int64_t, std::int64_t>> blocks;
+        blocks.reserve(nzones);
+        for (std::size_t i = 0; i < nzones; ++i)
+        {
+            time_zone z;
+            z.name_ = in.get_string();
+            auto b = in.get_int();
+            auto e = in.get_int();
+            blocks.emplace_back(b, e);
+            z.adjusted_.reset(new detail::zone_state);
+            tmp.zones.push_back(std::move(z));
+        }
+        auto sum = static_cast<std::uint64_t>(in.get_int());
+        auto zones_first = in.pos() - first;
+        if (checksum(in.pos(), size - static_cast<std::size_t>(zones_first)) != sum)
+            return false;
+        for (std::size_t i = 0; i < nzones; ++i)
+        {
+            auto b = blocks[i].first;
+            auto e = blocks[i].second;
+            if (b < zones_first || e < b || static_cast<std::uint64_t>(e) > size)
+                return false;
+            tmp.zones[i].snapshot_first_ = first + b;
+            tmp.zones[i].snapshot_last_ = first + e;
+        }
+    }
+    catch (const std::exception&)
+    {
+        return false;
+    }
+    db.rules = std::move(tmp.rules);
+    db.zones = std::move(tmp.zones);
+    db.links = std::move(tmp.links);
+    db.leaps = std::move(tmp.leaps);
+    db.snapshot_data = std::move(data);
+    return true;
+}
+
+// Parses the tzdata in path into a tzdb of its own, initializes all of its zones and
+// saves it to file, unless the tzdata no longer has this stamp once it is parsed.
+void
+snapshot::write(const std::string& path, const std::string& file,
+                const std::string& stamp, const std::string& version)
+{
+    tzdb db;
+    db.version = version;
+    parse_tzdata(path, db);
+    bind_rules(db);
+    if (snapshot::stamp(path) != stamp)
+        return;
+    db.prewarm_all();
+    save(file, stamp, db);
+}
+
+}  // namespace detail
+
+namespace
+{
+
+// Writes snapshots on a thread of its own, one at a time.  At exit a write still under
+// way is waited for, so that the next process finds the snapshot.
+struct snapshot_writer
+{
+    std::mutex        mut;
+    std::thread       thread;
+    std::atomic<bool> busy{false};
+
+    ~snapshot_writer()
+    {
+        if (thread.joinable())
+            thread.join();
+    }
+};
+
+snapshot_writer&
+get_snapshot_writer()
+{
+    static snapshot_writer w;
+    return w;
+}
+
+}  // unnamed namespace
+
+// Starts writing the snapshot of the tzdata in path, unless a write is already under
+// way.  The load that was just done then returns without waiting for every zone to be
+// initialized.  The writer parses the text again rather than use the loaded tzdb,
+// which may be erased before it is done.
+static
+void
+write_snapshot_later(const std::string& path, const std::string& file,
+                     const std::string& stamp, const std::string& version)
+{
+    auto& w = get_snapshot_writer();
+    std::lock_guard<std::mutex> lock(w.mut);
+    if (w.busy)
+        return;
+    if (w.thread.joinable())
+        w.thread.join();
+    w.busy = true;
+    try
+    {
+        w.thread = std::thread([&w, path, file, stamp, version]()
+                               {
+                                   try
+                                   {
+                                       detail::snapshot::write(path, file, stamp,
+                                                               version);
+                                   }
+                                   catch (const std::exception&)
+                                   {
+                                       // The text is simply parsed again next time.
+                                   }
+                                   w.busy = false;
+                               });
+    }
+    catch (const std::system_error&)
+    {
+        w.busy = false;
+    }
+}
+
+void
+detail::wait_for_snapshot()
+{
+    auto& w = get_snapshot_writer();
+    std::lock_guard<std::mutex> lock(w.mut);
+    if (w.thread.joinable())
+        w.thread.join();
+}
+
+#endif  // TZDB_SNAPSHOT
+
+static
+std::unique_ptr<tzdb>
+init_tzdb()
+{
+    using namespace date;
+    const std::string install = get_install();
+    const std::string path = install + folder_delimiter;
+    std::unique_ptr<tzdb> db(new tzdb);
+
+#if AUTO_DOWNLOAD
+    if (!file_exists(install))
+    {
+        auto rv = remote_version();
+        if (!rv.empty() && remote_download(rv))
+        {
+            if (!remote_install(rv))
+            {
+                std::string msg = "Timezone database version \"";
+                msg += rv;
+                msg += "\" did not install correctly to \"";
+                msg += install;
+                msg += "\"";
+                throw std::runtime_error(msg);
+            }
+        }
+        if (!file_exists(install))
+        {
+            std::string msg = "Timezone database not found at \"";
+            msg += install;
+            msg += "\"";
+            throw std::runtime_error(msg);
+        }
+        db->version = get_version(path);
+    }
+    else
+    {
+        db->version = get_version(path);
+        auto rv = remote_version();
+        if (!rv.empty() && db->version != rv)
+        {
+            if (remote_download(rv))
+            {
+                remote_install(rv);
+                db->version = get_version(path);
+            }
+        }
+    }
+#else  // !AUTO_DOWNLOAD
+    if (!file_exists(install))
+    {
+        std::string msg = "Timezone database not found at \"";
+        msg += install;
+        msg += "\"";
+        throw std::runtime_error(msg);
+    }
+    db->version = get_version(path);
+#endif  // !AUTO_DOWNLOAD
+
+#if TZDB_SNAPSHOT
+    const auto snapshot_file = detail::snapshot::file(install);
+    const auto stamp = detail::snapshot::stamp(path);
+    const bool loaded = !snapshot_file.empty() &&
+                        detail::snapshot::load(snapshot_file, stamp, *db);
+    if (!loaded)
+        parse_tzdata(path, *db);
+    detail::bind_rules(*db);
+    if (!loaded && !snapshot_file.empty())
+        write_snapshot_later(path, snapshot_file, stamp, db->version);
+#else  // !TZDB_SNAPSHOT
+    parse_tzdata(path, *db);
+    detail::bind_rules(*db);
+#endif  // !TZDB_SNAPSHOT
+
+#ifdef _WIN32
+    std::string mapping_file = get_install() + folder_delimiter + "windowsZones.xml";
+    db->mappings = load_timezone_mappings_from_xml_file(mapping_file);
+    sort_zone_mappings(db->mappings);
+#endif // _WIN32
+
+    build_name_index(*db);
+#if !MISSING_LEAP_SECONDS
+    build_leap_index(*db);
+#endif
+    return db;
+}
+
+const tzdb&
+reload_tzdb()
+{
+#if AUTO_DOWNLOAD
+    auto const& v = get_tzdb_list().front().version;
+    if (!v.empty() && v == remote_version())
+        return get_tzdb_list().front();
+#endif  // AUTO_DOWNLOAD
+    auto db = init_tzdb();
+    rematerialize(*db, get_tzdb_list().front());
+    tzdb_list::undocumented_helper::push_front(get_tzdb_list(), db.release());
+    return get_tzdb_list().front();
+}
+
+#endif  // !USE_OS_TZDB
+
+const tzdb&
+get_tzdb()
+{
+    return get_tzdb_list().front();
+}
+
+#if !MISSING_LEAP_SECONDS
+
+// leap-seconds.list
+
+// Parses a leap-seconds.list into t.  Each entry is a time in NTP seconds (since
+// 1900-01-01) followed by the TAI - UTC offset from then on.  The first entry sets the
+// initial offset, and each later one must add a leap second.  The "#@" line gives the
+// expiration date.
+static
+void
+parse_leap_seconds_list(const std::string& buf, const std::string& path,
+                        detail::leap_table& t)
+{
+    using std::chrono::seconds;
+    const seconds ntp_epoch = sys_days{1970_y/January/1} - sys_days{1900_y/January/1};
+    auto fail = [&path]()
+    {
+        throw std::runtime_error("Invalid leap second list " + path);
+    };
+    // Reads a decimal integer from [q, eol), skipping blanks but never the end of line.
+    auto read_int = [](const char*& q, const char* eol, long long& v)
+    {
+        while (q < eol && (*q == ' ' || *q == '\t' || *q == '\r'))
+            ++q;
+        bool neg = q < eol && *q == '-';
+        if (neg || (q < eol && *q == '+'))
+            ++q;
+        if (q == eol || !('0' <= *q && *q <= '9'))
+            return false;
+        v = 0;
+        for (; q < eol && '0' <= *q && *q <= '9'; ++q)
+            v = v * 10 + (*q - '0');
+        if (neg)
+            v = -v;
+        return true;
+    };
+    long long prev = 0;
+    bool first = true;
+    const char* p = buf.c_str();
+    const char* e = p + buf.size();
+    while (p < e)
+    {
+        auto eol = static_cast<const char*>(std::memchr(p, '\n', static_cast<std::size_t>(e - p)));
+        if (eol == nullptr)
+            eol = e;
+        if (p[0] == '#')
+        {
+            const char* q = p + 2;
+            long long ntp;
+            if (eol - p > 2 && p[1] == '@' && read_int(q, eol, ntp))
+                t.expires = sys_seconds{ntp * seconds{1} - ntp_epoch};
+        }
+        else
+        {
+            const char* q = p;
+            long long ntp;
+            if (read_int(q, eol, ntp))
+            {
+                long long dtai;
+                if (!read_int(q, eol, dtai))
+                    fail();
+                auto tp = sys_seconds{ntp * seconds{1} - ntp_epoch};
+                if (first)
+                    first = false;
+                else if (dtai != prev + 1 || (!t.dates.empty() && tp <= t.dates.back()))
+                    fail();
+                else
+                    t.dates.push_back(tp);
+                prev = dtai;
+            }
+        }
+        p = eol + 1;
+    }
+    if (first)
+        fail();
+}
+
+sys_seconds
+reload_leap_seconds(const std::string& path)
+{
+    std::string buf;
+    if (!read_file(path, buf))
+        throw std::runtime_error("Unable to open " + path);
+    std::unique_ptr<detail::leap_table> t(new detail::leap_table);
+    parse_leap_seconds_list(buf, path, *t);
+    index_leaps(*t);
+    // Loads the first database, if that hasn't happened, before taking the lock that
+    // publishing it takes.
+    detail::current_leaps();
+    auto& l = get_loaded_leap_tables();
+    std::lock_guard<std::mutex> lock(l.mut);
+    auto cur = detail::published_leaps.load(std::memory_order_relaxed);
+    if (newer_leaps(*cur, *t))
+        return cur->expires;
+    auto expires = t->expires;
+    l.loaded = t.get();
+    detail::published_leaps.store(t.get(), std::memory_order_release);
+    l.tables.push_back(std::move(t));
+    return expires;
+}
+
+sys_seconds
+reload_leap_seconds()
+{
+#if USE_OS_TZDB
+    return reload_leap_seconds(get_tz_dir() + folder_delimiter + "leap-seconds.list");
+#else
+    return reload_leap_seconds(get_install() + folder_delimiter + "leap-seconds.list");
+#endif
+}
+
+sys_seconds
+leap_seconds_expiration()
+{
+    return detail::current_leaps().expires;
+}
+
+// Called only until the first database is loaded, which publishes its leaps.
+const detail::leap_table&
+detail::load_current_leaps()
+{
+    get_tzdb_list();
+    return *published_leaps.load(std::memory_order_acquire);
+}
+
+#endif  // !MISSING_LEAP_SECONDS
+
+#if USE_TZDB_WATCHER
+
+namespace
+{
+
+struct tzdb_watcher
+{
+    std::mutex  mut;
+    std::thread thread;
+    int         stop_pipe[2] = {-1, -1};
+};
+
+// Never destroyed, so that a watcher still running at exit is simply abandoned.
+tzdb_watcher&
+get_tzdb_watcher()
+{
+    static auto w = new tzdb_watcher;
+    return *w;
+}
+
+}  // unnamed namespace
+
+// Runs on the watcher thread until stop_fd becomes readable.  Every change to the
+// watched folder restarts the settle timer; when it expires the database is reloaded.
+static
+void
+watch_tzdb(int inotify_fd, int stop_fd, std::chrono::milliseconds settle)
+{
+    pollfd fds[2] = {{inotify_fd, POLLIN, 0}, {stop_fd, POLLIN, 0}};
+    alignas(inotify_event) char buf[4096];
+    bool pending = false;
+    while (true)
+    {
+        auto n = ::poll(fds, 2, pending ? static_cast<int>(settle.count()) : -1);
+        if (n < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            break;
+        }
+        if (fds[1].revents != 0)
+            break;
+        if (n == 0)
+        {
+            pending = false;
+            try
+            {
+                auto db = init_tzdb();
+                rematerialize(*db, get_tzdb_list().front());
+                tzdb_list::undocumented_helper::push_front(get_tzdb_list(), db.release());
+            }
+            catch (const std::exception&)
+            {
+                // Most likely caught part way through an update.  Keep the current
+                // database and wait for the next change.
+            }
+            continue;
+        }
+        if (::read(inotify_fd, buf, sizeof(buf)) > 0)
+            pending = true;
+    }
+    ::close(inotify_fd);
+}
+
+void
+start_tzdb_watcher(std::chrono::milliseconds settle)
+{
+    auto& w = get_tzdb_watcher();
+    std::lock_guard<std::mutex> lock(w.mut);
+    if (w.thread.joinable())
+        return;
+    get_tzdb_list();
+#if USE_OS_TZDB
+    const auto& dir = get_tz_dir();
+#else
+    const auto& dir = get_install();
+#endif
+    auto fd = ::inotify_init1(IN_CLOEXEC);
+    if (fd < 0)
+        throw std::system_error(errno, std::system_category(), "inotify_init1() failed");
+    if (::inotify_add_watch(fd, dir.c_str(), IN_CLOSE_WRITE | IN_CREATE | IN_DELETE |
+                                             IN_MOVED_FROM | IN_MOVED_TO) < 0 ||
+        ::pipe2(w.stop_pipe, O_CLOEXEC) != 0)
+    {
+        auto err = errno;
+        ::close(fd);
+        throw std::system_error(err, std::system_category(), "unable to watch " + dir);
+    }
+    try
+    {
+        w.thread = std::thread(watch_tzdb, fd, w.stop_pipe[0], settle);
+    }
+    catch (...)
+    {
+        ::close(fd);
+        ::close(w.stop_pipe[0]);
+        ::close(w.stop_pipe[1]);
+        throw;
+    }
+}
+
+void
+stop_tzdb_watcher()
+{
+    auto& w = get_tzdb_watcher();
+    std::lock_guard<std::mutex> lock(w.mut);
+    if (!w.thread.joinable())
+        return;
+    char c = 0;
+    while (::write(w.stop_pipe[1], &c, 1) < 0 && errno == EINTR)
+        ;
+    w.thread.join();
+    ::close(w.stop_pipe[0]);
+    ::close(w.stop_pipe[1]);
+}
+
+#endif  // USE_TZDB_WATCHER
+
+const time_zone*
+#if HAS_STRING_VIEW
+tzdb::locate_zone(std::string_view tz_name) const
+#else
+tzdb::locate_zone(const std::string& tz_name) const
+#endif
+{
+    if (!name_index.empty())
+    {
+        if (auto z = find_in_name_index(*this, tz_name.data(), tz_name.size()))
+        {
+#if USE_OS_TZDB && USE_TZDATA_ZI
+            if (!has_zone_file(*z))
+                throw std::runtime_error(std::string(tz_name) +
+                                         " not found in timezone database");
+#endif
+            return z;
+        }
+#if USE_OS_TZDB && USE_TZDATA_ZI
+        if (auto z = locate_unlisted_zone(*this, std::string(tz_name)))
+            return z;
+#endif
+        throw std::runtime_error(std::string(tz_name) + " not found in timezone database");
+    }
+    auto zi = std::lower_bound(zones.begin(), zones.end(), tz_name,
+#if HAS_STRING_VIEW
+        [](const time_zone& z, const std::string_view& nm)
+#else
+        [](const time_zone& z, const std::string& nm)
+#endif
+        {
+            return z.name() < nm;
+        });
+    if (zi == zones.end() || zi->name() != tz_name)
     {
 #if !USE_OS_TZDB
         auto li = std::lower_bound(links.begin(), links.end(), tz_name,
@@ -3538,12 +6163,125 @@ tzdb::locate_zone(const std::string& tz_name) const
             if (zi != zones.end() && zi->name() == li->target())
                 return &*zi;
         }
-#endif  // !USE_OS_TZDB
+#elif USE_TZDATA_ZI
+        if (auto z = locate_unlisted_zone(*this, std::string(tz_name)))
+            return z;
+#endif  // USE_TZDATA_ZI
         throw std::runtime_error(std::string(tz_name) + " not found in timezone database");
     }
+#if USE_OS_TZDB && USE_TZDATA_ZI
+    if (!has_zone_file(*zi))
+        throw std::runtime_error(std::string(tz_name) + " not found in timezone database");
+#endif
     return &*zi;
 }
 
+void
+tzdb::prewarm(const std::vector<std::string>& names, unsigned threads) const
+{
+    std::vector<const time_zone*> zs;
+    zs.reserve(names.size());
+    for (const auto& name : names)
+        zs.push_back(locate_zone(name));
+    parallel_for(zs.size(), threads, [&](std::size_t i) {zs[i]->init();});
+}
+
+void
+tzdb::prewarm_all(unsigned threads) const
+{
+    parallel_for(zones.size(), threads, [this](std::size_t i) {zones[i].init();});
+}
+
+// Guards the zones' day tables and each tzdb's materialized.
+static std::mutex day_table_mutex;
+
+std::size_t
+tzdb::materialize(const std::string& name, year first, year last) const
+{
+    auto z = locate_zone(name);
+    std::unique_ptr<detail::day_table> t;
+    if (first <= last)
+    {
+        t.reset(new detail::day_table);
+        t->first = sys_days{first/January/1};
+        auto end = sys_days{last/December/31} + days{1};
+        t->entries.reserve(static_cast<std::size_t>((end - t->first).count()));
+        auto i = z->get_info(sys_seconds{t->first});
+        for (auto d = t->first; d < end; d += days{1})
+        {
+            while (i.end <= d)
+                i = z->get_info(i.end);
+            auto flag = 0;
+            for (auto j = i; j.end < d + days{1} && flag == 0;)
+            {
+                j = z->get_info(j.end);
+                flag = j.offset != i.offset;
+            }
+            t->entries.push_back(static_cast<std::int32_t>(i.offset.count() * 2 + flag));
+        }
+    }
+    auto r = t ? sizeof(detail::day_table) + t->entries.capacity() * sizeof(std::int32_t)
+               : std::size_t{0};
+    std::lock_guard<std::mutex> lock(day_table_mutex);
+    auto& st = *z->adjusted_;
+    st.days.store(t.get(), std::memory_order_release);
+    if (t)
+        st.tables.push_back(std::move(t));
+    auto i = std::find_if(materialized.begin(), materialized.end(),
+                          [z](const detail::materialize_request& q)
+                          {
+                              return q.name == z->name();
+                          });
+    if (first > last)
+    {
+        if (i != materialized.end())
+            materialized.erase(i);
+    }
+    else if (i != materialized.end())
+    {
+        i->first = first;
+        i->last = last;
+    }
+    else
+        materialized.push_back({z->name(), first, last});
+    return r;
+}
+
+// Builds the tables that materialize was asked for in old in db, which is about to
+// replace old at the front of the tzdb_list, and isn't yet seen by other threads.  A
+// zone that db no longer has is skipped.
+static
+void
+rematerialize(const tzdb& db, const tzdb& old)
+{
+    std::vector<detail::materialize_request> requests;
+    {
+        std::lock_guard<std::mutex> lock(day_table_mutex);
+        requests = old.materialized;
+    }
+    for (const auto& q : requests)
+    {
+        try
+        {
+            db.materialize(q.name, q.first, q.last);
+        }
+        catch (const std::runtime_error&)
+        {
+        }
+    }
+}
+
+std::size_t
+tzdb::materialized_bytes() const
+{
+    std::lock_guard<std::mutex> lock(day_table_mutex);
+    std::size_t r = 0;
+    for (const auto& z : zones)
+        if (auto t = z.adjusted_->days.load(std::memory_order_relaxed))
+            r += sizeof(detail::day_table) + t->entries.capacity() * sizeof(std::int32_t);
+    return r;
+}
+
 const time_zone*
 #if HAS_STRING_VIEW
 locate_zone(std::string_view tz_name)
@@ -3554,6 +6292,90 @@ locate_zone(const std::string& tz_name)
     return get_tzdb().locate_zone(tz_name);
 }
 
+// fixed_offset_zone
+
+static
+std::string
+offset_abbrev(std::chrono::minutes offset)
+{
+    auto m = offset.count();
+    std::string r(1, m < 0 ? '-' : '+');
+    if (m < 0)
+        m = -m;
+    auto put2 = [&r](long long x)
+    {
+        r += static_cast<char>('0' + x / 10 % 10);
+        r += static_cast<char>('0' + x % 10);
+    };
+    put2(m / 60);
+    if (m % 60 != 0)
+        put2(m % 60);
+    return r;
+}
+
+static
+sys_info
+make_offset_info(std::chrono::minutes offset)
+{
+    return {sys_days(year::min()/min_day), sys_days(year::max()/max_day), offset,
+            std::chrono::minutes{0}, offset_abbrev(offset)};
+}
+
+sys_info
+detail::fixed_offset_info(std::chrono::minutes offset)
+{
+    using std::chrono::minutes;
+    CONSTDATA auto step = 15;
+    CONSTDATA auto limit = 14 * 60;
+    static const std::vector<sys_info> interned = []()
+    {
+        std::vector<sys_info> v;
+        for (auto m = -limit; m <= limit; m += step)
+            v.push_back(make_offset_info(minutes{m}));
+        return v;
+    }();
+    auto m = offset.count();
+    if (-limit <= m && m <= limit && m % step == 0)
+        return interned[static_cast<std::size_t>((m + limit) / step)];
+    return make_offset_info(offset);
+}
+
+std::chrono::minutes
+detail::parse_utc_offset(const char* p, std::size_t n)
+{
+    using std::chrono::minutes;
+    auto fail = [p, n]()
+    {
+        throw std::runtime_error(std::string(p, n) + " is not a UTC offset");
+    };
+    if (n == 1 && *p == 'Z')
+        return minutes{0};
+    if (n < 2 || (*p != '+' && *p != '-'))
+        fail();
+    auto digit = [&](std::size_t i) -> int
+    {
+        if (i >= n || !('0' <= p[i] && p[i] <= '9'))
+            fail();
+        return p[i] - '0';
+    };
+    auto h = digit(1);
+    std::size_t i = 2;
+    if (i < n && p[i] != ':')
+        h = h * 10 + digit(i++);
+    int m = 0;
+    if (i < n)
+    {
+        if (p[i] == ':')
+            ++i;
+        m = digit(i) * 10 + digit(i + 1);
+        i += 2;
+    }
+    if (i != n || h > 23 || m > 59)
+        fail();
+    auto r = minutes{h * 60 + m};
+    return *p == '-' ? -r : r;
+}
+
 #if USE_OS_TZDB
 
 std::ostream&
@@ -0,0 +1,146 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Howard Hinnant
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// template <class CharT, class Traits = std::char_traits<CharT>>
+// class compiled_format;
+//
+// template <class CharT, class Traits, class Streamable>
+//     basic_string<CharT, Traits>
+//     format(const compiled_format<CharT, Traits>& fmt, const Streamable& tp);
+
+#include "date.h"
+#include <cassert>
+#include <ios>
+#include <sstream>
+#include <string>
+
+const char* formats[] =
+{
+    "",
+    "%F %T",
+    "%Y-%m-%dT%H:%M:%S%z",
+    "%Y%m%d %H%M%S %Ez %Oz",
+    "[%e] %j %a %b %y %D %R %I %p %%%n%t|",
+    "%Od %OH %EY %Ey %Em %OS %EH",
+    "%k %Q %q %EE %OO %E% literal",
+    "%C %g %G %u %U %V %w %W %c %x %X %r %h %A %B",
+    "%",
+    "%E",
+    "trailing %O",
+};
+
+// The output of f, or "throws" if it throws
+template <class F>
+std::string
+output(F f)
+{
+    try
+    {
+        return f();
+    }
+    catch (const std::ios_base::failure&)
+    {
+        return "throws";
+    }
+}
+
+template <class T>
+void
+test(const T& t)
+{
+    using namespace date;
+    for (auto f : formats)
+    {
+        compiled_format<char> cf(f);
+        assert(std::string(cf.c_str()) == f);
+        auto expected = output([&]() {return format(f, t);});
+        assert(output([&]() {return format(cf, t);}) == expected);
+        assert(output([&]() {return format(std::locale::classic(), cf, t);}) == expected);
+    }
+}
+
+template <class T>
+void
+test_throws(const char* f, const T& t)
+{
+    using namespace date;
+    compiled_format<char> cf(f);
+    bool threw = false;
+    try
+    {
+        format(cf, t);
+    }
+    catch (const std::ios_base::failure&)
+    {
+        threw = true;
+    }
+    assert(threw);
+}
+
+int
+main()
+{
+    using namespace date;
+    using namespace std::chrono;
+
+    auto tp = sys_days{2017_y/March/5} + hours{7} + minutes{3} + seconds{9};
+    test(tp);
+    test(tp + milliseconds{12});
+    test(time_point_cast<nanoseconds>(tp) + nanoseconds{123456789});
+    test(time_point_cast<duration<double>>(tp) + duration<double>{0.25});
+    test(sys_days{2017_y/March/15});
+    test(sys_days{1850_y/December/31} + hours{23});
+    test(sys_days{-3_y/January/1} + hours{1});
+    test(sys_days{12000_y/January/1});
+    test(local_days{2017_y/March/5} + hours{19});
+    test(2017_y/March/5);
+    test(2017_y/March);
+    test(hours{31} + minutes{5});
+    test(-(hours{3} + minutes{5} + milliseconds{7}));
+    test(year{2017});
+
+    std::string abbrev("EST");
+    seconds offset = -hours{5} - minutes{30};
+    auto lt = local_days{2017_y/March/5} + hours{2} + microseconds{5};
+    for (auto f : formats)
+    {
+        compiled_format<char> cf(f);
+        std::ostringstream a, b;
+        to_stream(a, cf, lt, &abbrev, &offset);
+        to_stream(b, f, lt, &abbrev, &offset);
+        assert(a.str() == b.str());
+        assert(a.fail() == b.fail());
+    }
+
+    // %z and %Z need an offset and an abbreviation
+    test_throws("%F %Z", local_days{2017_y/March/5});
+    test_throws("%F %z", local_days{2017_y/March/5});
+
+    // Invalid fields fail as they do for the format string
+    test_throws("%F", 2017_y/February/30);
+    test(2017_y/February/30);
+
+#if !ONLY_C_LOCALE
+    compiled_format<wchar_t> wcf(std::wstring(L"%F %T %Z"));
+    assert(format(wcf, tp) == L"2017-03-05 07:03:09 UTC");
+#endif
+}
@@ -0,0 +1,135 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Howard Hinnant
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// template <class OutputIt, class Format, class Streamable>
+//     OutputIt
+//     format_to(OutputIt out, const Format& fmt, const Streamable& tp);
+//
+// template <class OutputIt, class Format, class Streamable>
+//     format_to_n_result<OutputIt>
+//     format_to_n(OutputIt out, std::size_t n, const Format& fmt, const Streamable& tp);
+
+#include "date.h"
+#include <cassert>
+#include <cstring>
+#include <ios>
+#include <iterator>
+#include <string>
+
+const char* formats[] =
+{
+    "",
+    "%F %T",
+    "%Y-%m-%dT%H:%M:%S%z",
+    "%Y%m%d %H%M%S %Ez %Oz %Z",
+    "[%e] %j %a %b %y %D %R %I %p %%%n%t|",
+    "%Od %OH %EY %Ey %Em %OS %EH",
+    "%k %Q %q %EE %OO %E% literal",
+    "%C %g %G %u %U %V %w %W %c %x %X %r %h %A %B",
+    "%",
+    "trailing %O",
+};
+
+// The output of f, or "throws" if it throws
+template <class F>
+std::string
+output(F f)
+{
+    try
+    {
+        return f();
+    }
+    catch (const std::ios_base::failure&)
+    {
+        return "throws";
+    }
+}
+
+template <class T>
+void
+test(const T& t)
+{
+    using namespace date;
+    for (auto f : formats)
+    {
+        auto expected = output([&]() {return format(f, t);});
+        auto to_string = [&](const char* g)
+        {
+            std::string s;
+            date::format_to(std::back_inserter(s), g, t);
+            return s;
+        };
+        assert(output([&]() {return to_string(f);}) == expected);
+        assert(output([&]()
+        {
+            std::string s;
+            date::format_to(std::back_inserter(s), std::string(f), t);
+            return s;
+        }) == expected);
+        compiled_format<char> cf(f);
+        assert(output([&]()
+        {
+            std::string s;
+            date::format_to(std::back_inserter(s), cf, t);
+            return s;
+        }) == expected);
+        if (expected != "throws")
+        {
+            char buf[256];
+            auto r = date::format_to_n(buf, 10, cf, t);
+            assert(r.size == static_cast<std::ptrdiff_t>(expected.size()));
+            assert(r.out == buf + std::min<std::size_t>(10, expected.size()));
+            assert(std::string(buf, r.out) == expected.substr(0, 10));
+            r = date::format_to_n(buf, sizeof(buf), f, t);
+            assert(std::string(buf, r.out) == expected);
+        }
+    }
+}
+
+int
+main()
+{
+    using namespace date;
+    using namespace std::chrono;
+
+    auto tp = sys_days{2017_y/March/5} + hours{7} + minutes{3} + seconds{9};
+    test(tp);
+    test(tp + milliseconds{12});
+    test(time_point_cast<nanoseconds>(tp) + nanoseconds{123456789});
+    test(time_point_cast<duration<double>>(tp) + duration<double>{0.25});
+    test(sys_days{2017_y/March/15});
+    test(sys_days{1850_y/December/31} + hours{23});
+    test(sys_days{-3_y/January/1} + hours{1});
+    test(sys_days{12000_y/January/1});
+    test(local_days{2017_y/March/5} + hours{19});
+    test(2017_y/March/5);
+    test(2017_y/February/30);
+    test(hours{31} + minutes{5});
+    test(-(hours{3} + minutes{5} + milliseconds{7}));
+    test(year{2017});
+
+    char buf[32];
+    auto e = date::format_to(buf, "%F %T", tp);
+    assert(std::string(buf, e) == "2017-03-05 07:03:09");
+    auto r = date::format_to_n(buf, 4, "%F %T", tp);
+    assert(r.size == 19 && r.out == buf + 4 && std::memcmp(buf, "2017", 4) == 0);
+}
@@ -0,0 +1,85 @@
+#ifndef TEMP_INSTALL_H
+#define TEMP_INSTALL_H
+
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Howard Hinnant
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// A temporary folder for tests that load the database from files they write
+
+#include "tz.h"
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <vector>
+
+class TempInstall
+{
+    std::string              dir_;
+    std::vector<std::string> files_;
+
+public:
+    // Creates /tmp/<prefix>_XXXXXX.
+    explicit TempInstall(const std::string& prefix)
+    {
+        std::string tmpl = "/tmp/" + prefix + "_XXXXXX";
+        dir_ = mkdtemp(&tmpl[0]);
+    }
+
+    // Removes the files written or remembered, in that order, and then the folder.
+    ~TempInstall()
+    {
+        for (auto const& f : files_)
+            std::remove((dir_ + '/' + f).c_str());
+        std::remove(dir_.c_str());
+    }
+
+    TempInstall(const TempInstall&) = delete;
+    TempInstall& operator=(const TempInstall&) = delete;
+
+    const std::string& dir() const {return dir_;}
+
+    // Opens file in the folder for writing, replacing what was there.
+    std::ofstream
+    write(const std::string& file)
+    {
+        remember(file);
+        return std::ofstream(dir_ + '/' + file, std::ios::binary);
+    }
+
+    // Has the destructor remove file, which something else created in the folder.
+    void
+    remember(const std::string& file)
+    {
+        for (auto const& f : files_)
+            if (f == file)
+                return;
+        files_.push_back(file);
+    }
+
+#if !USE_OS_TZDB
+    // Makes this folder the one the database is loaded from.
+    void install() const {date::set_install(dir_);}
+#endif
+};
+
+#endif // TEMP_INSTALL_H
@@ -0,0 +1,96 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Howard Hinnant
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// template <class InputIterator, class OutputIterator>
+//     OutputIterator
+//     time_zone::to_local(InputIterator first, InputIterator last, OutputIterator result) const;
+//
+// template <class InputIterator, class OutputIterator>
+//     OutputIterator
+//     time_zone::to_sys(InputIterator first, InputIterator last, OutputIterator result) const;
+//
+// template <class InputIterator, class OutputIterator>
+//     OutputIterator
+//     time_zone::to_sys(InputIterator first, InputIterator last, OutputIterator result,
+//                       choose z) const;
+//
+// template <class InputIterator, class OutputIterator>
+//     OutputIterator
+//     time_zone::get_offsets(InputIterator first, InputIterator last,
+//                            OutputIterator result) const;
+
+#include "tz.h"
+#include <cassert>
+#include <iterator>
+#include <vector>
+
+int
+main()
+{
+    using namespace std::chrono;
+    using namespace date;
+    auto z = locate_zone("America/New_York");
+
+    // sorted, spanning many transitions and more than one chunk
+    std::vector<sys_time<milliseconds>> st;
+    for (auto tp = sys_time<milliseconds>{sys_days{2010_y/jan/1}};
+              tp < sys_days{2020_y/jan/1}; tp += hours{7} + milliseconds{1})
+        st.push_back(tp);
+    std::vector<local_time<milliseconds>> lt(st.size());
+    assert(z->to_local(st.begin(), st.end(), lt.begin()) == lt.end());
+    std::vector<seconds> offsets;
+    z->get_offsets(st.begin(), st.end(), std::back_inserter(offsets));
+    assert(offsets.size() == st.size());
+    for (std::size_t i = 0; i < st.size(); ++i)
+    {
+        assert(lt[i] == z->to_local(st[i]));
+        assert(offsets[i] == z->get_info(st[i]).offset);
+    }
+    std::vector<sys_time<milliseconds>> back(lt.size());
+    z->to_sys(lt.begin(), lt.end(), back.begin(), choose::earliest);
+    for (std::size_t i = 0; i < lt.size(); ++i)
+        assert(back[i] == z->to_sys(lt[i], choose::earliest));
+
+    // unsorted
+    sys_seconds mixed[] = {sys_days{2016_y/jul/1}, sys_days{1999_y/jan/1},
+                           sys_days{2016_y/jan/1}, sys_days{2016_y/jul/2}};
+    local_seconds lmixed[4];
+    z->to_local(std::begin(mixed), std::end(mixed), lmixed);
+    for (int i = 0; i < 4; ++i)
+        assert(lmixed[i] == z->to_local(mixed[i]));
+
+    // nonexistent and ambiguous local times
+    local_seconds gap_fold[] = {local_days{2016_y/mar/13} + hours{2} + minutes{30},
+                                local_days{2016_y/nov/6} + hours{1} + minutes{30}};
+    sys_seconds r[2];
+    z->to_sys(std::begin(gap_fold), std::end(gap_fold), r, choose::latest);
+    assert(r[0] == z->to_sys(gap_fold[0], choose::latest));
+    assert(r[1] == z->to_sys(gap_fold[1], choose::latest));
+    try
+    {
+        z->to_sys(std::begin(gap_fold), std::end(gap_fold), r);
+        assert(false);
+    }
+    catch (const nonexistent_local_time&)
+    {
+    }
+}
@@ -0,0 +1,67 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Howard Hinnant
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// zoned_time with a caching_zone gives the same answers as with a plain time_zone*.
+
+#include "tz.h"
+#include <cassert>
+#include <stdexcept>
+
+int
+main()
+{
+    using namespace date;
+    using namespace std::chrono;
+
+    auto ny = locate_zone("America/New_York");
+    zoned_time<seconds, caching_zone<>> czt{"America/New_York"};
+    assert(czt.get_time_zone().get() == ny);
+    zoned_time<seconds> zt{ny};
+    for (sys_seconds tp = sys_days{2016_y/jan/1}; tp < sys_days{2018_y/jan/1}; tp += minutes{97})
+    {
+        czt = tp;
+        zt = tp;
+        assert(czt.get_local_time() == zt.get_local_time());
+        assert(czt.get_info().abbrev == zt.get_info().abbrev);
+        assert(format("%F %T %Z", czt) == format("%F %T %Z", zt));
+
+        auto lt = zt.get_local_time();
+        auto cz = czt.get_time_zone();
+        assert(cz->to_sys(lt, choose::earliest) == ny->to_sys(lt, choose::earliest));
+        assert(cz->to_sys(lt, choose::latest) == ny->to_sys(lt, choose::latest));
+    }
+
+    zoned_time<seconds, caching_zone<>> c2{ny, sys_seconds{sys_days{2017_y/mar/1}}};
+    assert(c2.get_time_zone() == czt.get_time_zone());
+    local_seconds skipped = local_days{2017_y/mar/12} + hours{2} + minutes{30};
+    try
+    {
+        c2 = skipped;
+        assert(false);
+    }
+    catch (const nonexistent_local_time&)
+    {
+    }
+    local_seconds repeated = local_days{2017_y/nov/5} + hours{1} + minutes{30};
+    zoned_time<seconds, caching_zone<>> c3{ny, repeated, choose::latest};
+    assert(c3.get_sys_time() == sys_days{2017_y/nov/5} + hours{6} + minutes{30});
+}
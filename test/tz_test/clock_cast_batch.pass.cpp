@@ -0,0 +1,126 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Howard Hinnant
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// template <class DstClock, class InputIterator, class OutputIterator>
+//     OutputIterator
+//     clock_cast(InputIterator first, InputIterator last, OutputIterator result);
+
+#include "tz.h"
+#include <algorithm>
+#include <cassert>
+#include <vector>
+
+// A clock 1000 s behind system_clock, reached only through to_sys / from_sys
+struct behind_clock
+{
+    using duration                  = std::chrono::milliseconds;
+    using rep                       = duration::rep;
+    using period                    = duration::period;
+    using time_point                = std::chrono::time_point<behind_clock, duration>;
+    static const bool is_steady     = false;
+
+    template <class Duration>
+    static
+    date::sys_time<Duration>
+    to_sys(const std::chrono::time_point<behind_clock, Duration>& tp)
+    {
+        return date::sys_time<Duration>{tp.time_since_epoch() + std::chrono::seconds{1000}};
+    }
+
+    template <class Duration>
+    static
+    std::chrono::time_point<behind_clock, Duration>
+    from_sys(const date::sys_time<Duration>& tp)
+    {
+        using TP = std::chrono::time_point<behind_clock, Duration>;
+        return TP{tp.time_since_epoch() - std::chrono::seconds{1000}};
+    }
+};
+
+template <class DstClock, class T>
+void
+check(const std::vector<T>& v)
+{
+    using R = decltype(date::clock_cast<DstClock>(v.front()));
+    std::vector<R> r(v.size());
+    assert(date::clock_cast<DstClock>(v.begin(), v.end(), r.begin()) == r.end());
+    for (std::size_t i = 0; i < v.size(); ++i)
+        assert(r[i] == date::clock_cast<DstClock>(v[i]));
+}
+
+int
+main()
+{
+    using namespace std::chrono;
+    using namespace date;
+
+    // sorted, every 250 ms through two leap seconds
+    std::vector<sys_time<milliseconds>> st;
+    for (auto tp = sys_time<milliseconds>{sys_days{2015_y/June/30}} + hours{23};
+              tp < sys_days{2017_y/January/1} + hours{1}; tp += milliseconds{250})
+    {
+        st.push_back(tp);
+        if (tp == sys_days{2015_y/July/1} + hours{1})
+            tp = sys_days{2016_y/December/31} + hours{23};
+    }
+    std::vector<utc_time<milliseconds>> ut;
+    for (auto tp : st)
+        ut.push_back(clock_cast<utc_clock>(tp));
+    // 23:59:60 of both leap seconds
+    ut.push_back(clock_cast<utc_clock>(sys_days{2015_y/July/1}) - milliseconds{500});
+    ut.push_back(clock_cast<utc_clock>(sys_days{2017_y/January/1}) - milliseconds{1});
+    std::sort(ut.begin(), ut.end());
+
+    check<utc_clock>(st);
+    check<tai_clock>(st);
+    check<gps_clock>(st);
+    check<behind_clock>(st);
+    check<std::chrono::system_clock>(ut);
+    check<tai_clock>(ut);
+    check<gps_clock>(ut);
+    check<behind_clock>(ut);
+
+    std::vector<gps_time<milliseconds>> gt;
+    for (auto tp : ut)
+        gt.push_back(clock_cast<gps_clock>(tp));
+    check<std::chrono::system_clock>(gt);
+    check<utc_clock>(gt);
+    check<tai_clock>(gt);
+    check<behind_clock>(gt);
+
+    std::vector<behind_clock::time_point> bt;
+    for (auto tp : st)
+        bt.push_back(clock_cast<behind_clock>(tp));
+    check<gps_clock>(bt);
+    check<utc_clock>(bt);
+
+    // unsorted, from before the first leap second to after the last
+    std::vector<sys_seconds> u;
+    for (int i = 0; i < 2000; ++i)
+        u.push_back(sys_days{1960_y/January/1} + seconds{(i * 7919LL % 2000) * 1000003});
+    check<gps_clock>(u);
+    check<utc_clock>(u);
+    std::vector<tai_seconds> ta;
+    for (auto tp : u)
+        ta.push_back(clock_cast<tai_clock>(tp));
+    check<std::chrono::system_clock>(ta);
+}
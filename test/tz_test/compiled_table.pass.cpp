@@ -0,0 +1,130 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Howard Hinnant
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// The text backend answers get_info from a precomputed table for the years
+// [COMPILED_FIRST_YEAR, COMPILED_LAST_YEAR], and by walking the rules outside of them.
+// Around both ends of the table, for every zone, the two must agree.
+
+#include "tz.h"
+#include <cassert>
+
+#if !USE_OS_TZDB
+
+#ifndef COMPILED_FIRST_YEAR
+#  define COMPILED_FIRST_YEAR 1970
+#endif
+#ifndef COMPILED_LAST_YEAR
+#  define COMPILED_LAST_YEAR 2037
+#endif
+
+static
+bool
+same(const date::sys_info& x, const date::sys_info& y)
+{
+    return x.begin == y.begin && x.end == y.end && x.offset == y.offset &&
+           x.save == y.save && x.abbrev == y.abbrev;
+}
+
+// Checks sys and local lookups in the two days either side of boundary.
+static
+void
+test(const date::time_zone& z, date::sys_seconds boundary)
+{
+    using namespace std::chrono;
+    using namespace date;
+    const seconds steps[] = {-days{2}, -days{1} - seconds{1}, -days{1}, -hours{12},
+                             -hours{1}, -seconds{1}, seconds{0}, seconds{1}, hours{1},
+                             hours{12}, days{1}, days{1} + seconds{1}, days{2}};
+    for (auto s : steps)
+    {
+        auto tp = boundary + s;
+        auto i = z.get_info(tp);
+        assert(i.begin <= tp && tp < i.end);
+        // Lookups on the other side of the boundary find the same period
+        for (auto t : steps)
+        {
+            auto tp2 = boundary + t;
+            if (i.begin <= tp2 && tp2 < i.end)
+                assert(same(z.get_info(tp2), i));
+        }
+        // and so do its neighbours, short of the ends of the database
+        if (i.begin > sys_days{1850_y/January/1})
+            assert(z.get_info(i.begin - seconds{1}).end == i.begin);
+        if (i.end < sys_days{2200_y/January/1})
+            assert(z.get_info(i.end).begin == i.end);
+
+        // A local time maps to the periods its sys_times fall in
+        auto lt = local_seconds{tp.time_since_epoch()};
+        auto l = z.get_info(lt);
+        auto in = [lt](const sys_info& x)
+        {
+            auto u = sys_seconds{(lt - x.offset).time_since_epoch()};
+            return x.begin <= u && u < x.end;
+        };
+        switch (l.result)
+        {
+        case local_info::unique:
+            assert(in(l.first));
+            assert(same(z.get_info(sys_seconds{(lt - l.first.offset).time_since_epoch()}),
+                        l.first));
+            break;
+        case local_info::ambiguous:
+            assert(in(l.first) && in(l.second));
+            assert(l.first.end == l.second.begin);
+            break;
+        case local_info::nonexistent:
+            assert(!in(l.first) && !in(l.second));
+            assert(l.first.end == l.second.begin);
+            break;
+        }
+    }
+}
+
+int
+main()
+{
+    using namespace date;
+    auto first = sys_seconds{sys_days{year{COMPILED_FIRST_YEAR}/January/1}};
+    auto last = sys_seconds{sys_days{year{COMPILED_LAST_YEAR + 1}/January/1}};
+    for (auto const& z : get_tzdb().zones)
+    {
+        test(z, first);
+        test(z, last);
+        // The table runs from the start of the period in effect at first to the end of
+        // the one in effect at last.
+        auto b = z.get_info(first).begin;
+        if (b > sys_days{1850_y/January/1})
+            test(z, b);
+        auto e = z.get_info(last - std::chrono::seconds{1}).end;
+        if (e < sys_days{2200_y/January/1})
+            test(z, e);
+    }
+}
+
+#else  // USE_OS_TZDB
+
+int
+main()
+{
+}
+
+#endif  // USE_OS_TZDB
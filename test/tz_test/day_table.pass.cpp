@@ -0,0 +1,84 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Howard Hinnant
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Test tzdb::materialize and the day table it gives time_zone::to_local.
+
+#include "tz.h"
+#include <cassert>
+#include <vector>
+
+int
+main()
+{
+    using namespace date;
+    using namespace std::chrono;
+    auto& db = get_tzdb();
+    auto z = db.locate_zone("America/New_York");
+    std::vector<local_seconds> expected;
+    auto first = sys_seconds{sys_days{2023_y/December/30}};
+    auto last = sys_seconds{sys_days{2025_y/January/3}};
+    for (auto tp = first; tp < last; tp += hours{1} + minutes{7})
+        expected.push_back(z->to_local(tp));
+
+    auto n = db.materialize("America/New_York", 2024_y, 2024_y);
+    assert(n >= 366 * sizeof(std::int32_t));
+    assert(db.materialized_bytes() == n);
+    std::size_t k = 0;
+    for (auto tp = first; tp < last; tp += hours{1} + minutes{7}, ++k)
+        assert(z->to_local(tp) == expected[k]);
+    auto t = sys_seconds{sys_days{2024_y/July/4}} + hours{12};
+    assert(z->to_local(t) == local_seconds{t.time_since_epoch()} - hours{4});
+
+    // Replacing the table
+    n = db.materialize("America/New_York", 2020_y, 2029_y);
+    assert(n >= 3653 * sizeof(std::int32_t));
+    assert(db.materialized_bytes() == n);
+    k = 0;
+    for (auto tp = first; tp < last; tp += hours{1} + minutes{7}, ++k)
+        assert(z->to_local(tp) == expected[k]);
+
+    assert(db.materialize("America/New_York", 2025_y, 2024_y) == 0);
+    assert(db.materialized_bytes() == 0);
+    k = 0;
+    for (auto tp = first; tp < last; tp += hours{1} + minutes{7}, ++k)
+        assert(z->to_local(tp) == expected[k]);
+
+#if !USE_OS_TZDB
+    // A reloaded database builds the tables asked of the one it replaces.
+    n = db.materialize("US/Eastern", 2024_y, 2024_y);
+    auto& db2 = reload_tzdb();
+    assert(&db2 != &db);
+    assert(db2.materialized_bytes() == n);
+    assert(db2.materialized.size() == 1);
+    assert(db2.materialized.front().name == "America/New_York");
+    auto z2 = db2.locate_zone("America/New_York");
+    k = 0;
+    for (auto tp = first; tp < last; tp += hours{1} + minutes{7}, ++k)
+        assert(z2->to_local(tp) == expected[k]);
+
+    // The requests belong to each database:  one made of a database that has been
+    // replaced isn't carried over.
+    db2.materialize("America/New_York", 2025_y, 2024_y);
+    db.materialize("America/New_York", 2024_y, 2024_y);
+    assert(reload_tzdb().materialized_bytes() == 0);
+#endif  // !USE_OS_TZDB
+}
@@ -0,0 +1,77 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Howard Hinnant
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// zoned_time with a fixed_offset_zone.
+
+#include "tz.h"
+#include <cassert>
+#include <sstream>
+#include <stdexcept>
+
+int
+main()
+{
+    using namespace date;
+    using namespace std::chrono;
+
+    CONSTDATA auto kolkata = fixed_offset_zone{hours{5} + minutes{30}};
+#if __cplusplus >= 201402
+    static_assert(kolkata.to_local(sys_days{2020_y/jan/1}) ==
+                  local_days{2020_y/jan/1} + hours{5} + minutes{30}, "");
+    static_assert(kolkata.to_sys(local_days{2020_y/jan/1}) ==
+                  sys_days{2019_y/dec/31} + hours{18} + minutes{30}, "");
+#endif
+
+    zoned_time<seconds, fixed_offset_zone> zt{kolkata, sys_seconds{sys_days{2020_y/jan/1}}};
+    assert(zt.get_local_time() == local_days{2020_y/jan/1} + hours{5} + minutes{30});
+    assert(format("%F %T %z %Z", zt) == "2020-01-01 05:30:00 +0530 +0530");
+
+    zoned_time<seconds, fixed_offset_zone> ny{"-05:00", local_seconds{local_days{2020_y/jan/1}}};
+    assert(ny.get_sys_time() == sys_days{2020_y/jan/1} + hours{5});
+    assert(format("%Z", ny) == "-05");
+    assert(ny.get_time_zone() == fixed_offset_zone{hours{-5}});
+    zoned_time<seconds, fixed_offset_zone> utc{"Z"};
+    assert(utc.get_info().abbrev == "+00");
+    assert(utc.get_info().begin == sys_days(year::min()/jan/1));
+    assert(utc.get_info().end == sys_days(year::max()/dec/31));
+    assert(fixed_offset_zone{minutes{-457}}.get_info(sys_days{}).abbrev == "-0737");
+
+    std::istringstream in{"2020-06-01 12:00:00 -0330"};
+    local_seconds lt;
+    minutes offset;
+    in >> parse("%F %T %z", lt, offset);
+    assert(!in.fail());
+    zoned_time<seconds, fixed_offset_zone> parsed{fixed_offset_zone{offset}, lt};
+    assert(parsed.get_sys_time() == sys_days{2020_y/jun/1} + hours{15} + minutes{30});
+
+    for (auto bad : {"", "+", "05:00", "+5:3", "+24", "+05:60", "+05:00x"})
+    {
+        try
+        {
+            zoned_traits<fixed_offset_zone>::locate_zone(bad);
+            assert(false);
+        }
+        catch (const std::runtime_error&)
+        {
+        }
+    }
+}
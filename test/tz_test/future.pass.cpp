@@ -0,0 +1,150 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Howard Hinnant
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Transitions long after the last one that the database lists explicitly.
+
+#include "tz.h"
+#include <cassert>
+#include <cstdint>
+#include <string>
+
+#if USE_OS_TZDB && !defined(_WIN32)
+
+#include "TempInstall.h"
+#include "tz_private.h"
+
+static
+void
+put_be(std::string& s, std::int64_t x, int n)
+{
+    for (int k = n - 1; k >= 0; --k)
+        s += static_cast<char>(x >> 8*k & 0xFF);
+}
+
+// A version 2 TZif file for a zone that goes from EST to EDT at the start of 2000, and
+// then keeps EDT all year by its footer.
+static
+std::string
+all_year_dst_tzif()
+{
+    std::string s;
+    auto header = [&s](int timecnt, int typecnt, int charcnt)
+    {
+        s += "TZif2";
+        s.append(15, '\0');
+        for (auto n : {0, 0, 0, timecnt, typecnt, charcnt})
+            put_be(s, n, 4);
+    };
+    header(0, 1, 4);
+    put_be(s, -18000, 4);
+    s += '\0';
+    s += '\0';
+    s.append("EST\0", 4);
+    header(1, 2, 8);
+    put_be(s, 946684800, 8);
+    s += '\1';
+    put_be(s, -18000, 4);
+    s += '\0';
+    s += '\0';
+    put_be(s, -14400, 4);
+    s += '\1';
+    s += '\4';
+    s.append("EST\0EDT\0", 8);
+    s += "\nEST5EDT,0/0,J365/25\n";
+    return s;
+}
+
+#endif  // USE_OS_TZDB && !defined(_WIN32)
+
+int
+main()
+{
+    using namespace date;
+    using namespace std::chrono;
+
+    auto ny = locate_zone("America/New_York");
+    auto i = ny->get_info(sys_days{2100_y/jul/1});
+    assert(i.begin == sys_days{2100_y/mar/14} + hours{7});
+    assert(i.end == sys_days{2100_y/nov/7} + hours{6});
+    assert(i.offset == hours{-4});
+    assert(i.abbrev == "EDT");
+    i = ny->get_info(sys_days{2100_y/dec/1});
+    assert(i.begin == sys_days{2100_y/nov/7} + hours{6});
+    assert(i.end == sys_days{2101_y/mar/13} + hours{7});
+    assert(i.offset == hours{-5});
+
+    auto li = ny->get_info(local_days{2100_y/mar/14} + hours{2} + minutes{30});
+    assert(li.result == local_info::nonexistent);
+    assert(li.first.offset == hours{-5});
+    assert(li.second.offset == hours{-4});
+    li = ny->get_info(local_days{2100_y/nov/7} + hours{1} + minutes{30});
+    assert(li.result == local_info::ambiguous);
+    assert(li.first.offset == hours{-4});
+    assert(li.second.offset == hours{-5});
+
+    // Southern hemisphere, where daylight saving time spans the new year
+    auto syd = locate_zone("Australia/Sydney");
+    i = syd->get_info(sys_days{2100_y/jan/1});
+    assert(i.begin == sys_days{2099_y/oct/3} + hours{16});
+    assert(i.end == sys_days{2100_y/apr/3} + hours{16});
+    assert(i.offset == hours{11});
+    assert(i.abbrev == "AEDT");
+
+    // The last year that can be represented.  Periods that would go on into the next
+    // year end with it.
+    auto last = sys_days{year::max()/dec/31};
+    i = ny->get_info(sys_days{year::max()/jul/1});
+    assert(i.end < last);
+    assert(i.offset == hours{-4});
+    assert(i.abbrev == "EDT");
+    i = ny->get_info(last - days{1});
+    assert(i.begin < last - days{1});
+    assert(i.end == last);
+    assert(i.offset == hours{-5});
+    i = syd->get_info(last - days{1});
+    assert(i.end == last);
+    assert(i.offset == hours{11});
+    i = syd->get_info(sys_days{year::min()/jan/1});
+    assert(i.begin == sys_days{year::min()/jan/1});
+
+#if USE_OS_TZDB && !defined(_WIN32)
+    // Daylight saving time all year.  The footer has no transitions, so every time
+    // after the file's last one is in the same period.
+    TempInstall tmp("future");
+    tmp.write("all_year_dst.tzif") << all_year_dst_tzif();
+    const std::string file = tmp.dir() + "/all_year_dst.tzif";
+    time_zone dst{"../../../../../../../.." + file, detail::undocumented{}};
+    for (auto d : {sys_days{2000_y/jul/1}, sys_days{2100_y/jan/1}, sys_days{2100_y/dec/31},
+                   sys_days{2200_y/jul/1}})
+    {
+        i = dst.get_info(d);
+        assert(i.begin == sys_days{2000_y/jan/1});
+        assert(i.end == sys_days{year::max()/dec/31});
+        assert(i.offset == hours{-4});
+        assert(i.save != minutes{0});
+        assert(i.abbrev == "EDT");
+    }
+    li = dst.get_info(local_days{2150_y/jan/1});
+    assert(li.result == local_info::unique);
+    assert(li.first.abbrev == "EDT");
+#endif  // USE_OS_TZDB && !defined(_WIN32)
+}
@@ -0,0 +1,108 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Howard Hinnant
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// struct sys_info_view
+// {
+//     sys_seconds          begin;
+//     sys_seconds          end;
+//     std::chrono::seconds offset;
+//     std::chrono::minutes save;
+//     std::string_view     abbrev;
+// };
+//
+// struct local_info_view
+// {
+//     enum {unique, nonexistent, ambiguous} result;
+//     sys_info_view first;
+//     sys_info_view second;
+// };
+//
+// template <class Duration> sys_info_view   time_zone::get_info_view(sys_time<Duration> st) const;
+// template <class Duration> local_info_view time_zone::get_info_view(local_time<Duration> tp) const;
+
+#include "tz.h"
+#include <cassert>
+
+#if HAS_STRING_VIEW
+
+static
+bool
+same(const date::sys_info_view& x, const date::sys_info& y)
+{
+    return x.begin == y.begin && x.end == y.end && x.offset == y.offset &&
+           x.save == y.save && x.abbrev == y.abbrev;
+}
+
+static
+bool
+same(const date::local_info_view& x, const date::local_info& y)
+{
+    return x.result == static_cast<int>(y.result) && same(x.first, y.first) &&
+           same(x.second, y.second);
+}
+
+#endif  // HAS_STRING_VIEW
+
+int
+main()
+{
+#if HAS_STRING_VIEW
+    using namespace std::chrono;
+    using namespace date;
+    for (auto name : {"America/New_York", "Europe/London", "Australia/Lord_Howe",
+                      "Asia/Kolkata", "Etc/UTC"})
+    {
+        auto z = locate_zone(name);
+        for (auto tp : {sys_days{1900_y/jan/1}, sys_days{1970_y/jan/1},
+                        sys_days{2016_y/mar/13}, sys_days{2016_y/nov/6},
+                        sys_days{2030_y/jul/1}, sys_days{2100_y/jan/1}})
+        {
+            for (auto h = hours{-3}; h <= hours{3}; ++h)
+            {
+                auto st = tp + h;
+                assert(same(z->get_info_view(st), z->get_info(st)));
+                auto lt = local_seconds{st.time_since_epoch()};
+                assert(same(z->get_info_view(lt), z->get_info(lt)));
+            }
+        }
+    }
+
+    auto z = locate_zone("America/New_York");
+    auto i = z->get_info_view(local_days{2016_y/mar/13} + 2h + 30min);
+    assert(i.result == local_info_view::nonexistent);
+    assert(i.first.abbrev == "EST");
+    assert(i.second.abbrev == "EDT");
+    i = z->get_info_view(local_days{2016_y/nov/6} + 1h + 30min);
+    assert(i.result == local_info_view::ambiguous);
+    assert(i.first.abbrev == "EDT");
+    assert(i.second.abbrev == "EST");
+
+    // Far from the present the abbreviation still comes from storage the zone owns,
+    // so every period with the same one shares it.
+    auto s1 = z->get_info_view(sys_days{2300_y/jul/1});
+    auto s2 = z->get_info_view(sys_days{2400_y/jul/1});
+    auto w1 = z->get_info_view(sys_days{2300_y/jan/1});
+    assert(s1.abbrev == "EDT" && w1.abbrev == "EST");
+    assert(s1.abbrev.data() == s2.abbrev.data());
+    assert(s1.abbrev.data() != w1.abbrev.data());
+#endif  // HAS_STRING_VIEW
+}
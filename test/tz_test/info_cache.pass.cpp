@@ -0,0 +1,122 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Howard Hinnant
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// The per-thread sys_info cache answers get_info, get_info_view, to_sys, to_local
+// and zoned_time alike.
+
+#include "tz.h"
+#include <cassert>
+
+#if USE_INFO_CACHE
+
+int
+main()
+{
+    using namespace date;
+    using namespace std::chrono;
+
+    auto z = locate_zone("America/New_York");
+    auto tp = sys_days{2017_y/July/4} + hours{12};
+
+    reset_info_cache_stats();
+    auto i = z->get_info(tp);
+    auto s = get_info_cache_stats();
+    assert(s.hits == 0);
+    assert(s.misses == 1);
+
+    z->get_info(tp + hours{1});
+    s = get_info_cache_stats();
+    assert(s.hits == 1);
+    assert(s.misses == 1);
+
+#if HAS_STRING_VIEW
+    // get_info and get_info_view share entries, either way around.
+    reset_info_cache_stats();
+    auto v = z->get_info_view(tp);
+    s = get_info_cache_stats();
+    assert(s.hits == 1);
+    assert(s.misses == 0);
+    assert(v.begin == i.begin && v.end == i.end && v.abbrev == i.abbrev);
+
+    auto jan = z->get_info_view(sys_days{2017_y/January/4});
+    auto li = z->get_info(local_days{2017_y/January/10});
+    s = get_info_cache_stats();
+    assert(s.hits == 2);
+    assert(s.misses == 1);
+    assert(li.result == local_info::unique);
+    assert(li.first.begin == jan.begin && li.first.abbrev == "EST");
+    assert(z->get_info(local_days{2017_y/January/10}).first.abbrev == "EST");
+
+    // to_local, to_sys and zoned_time go through get_info_view.
+    z->get_info(tp);
+    reset_info_cache_stats();
+    auto lt = z->to_local(tp);
+    auto st = z->to_sys(lt);
+    assert(st == tp);
+    zoned_time<seconds> zt{z, tp + hours{3}};
+    assert(zt.get_info().abbrev == "EDT");
+    s = get_info_cache_stats();
+    assert(s.misses == 0);
+    assert(s.hits >= 3);
+
+    // The view's abbrev stays valid once the entry is replaced.
+    auto w = z->get_info_view(sys_days{2017_y/January/4});
+    assert(w.abbrev == "EST");
+    z->get_info(sys_days{2017_y/July/4});
+    assert(w.abbrev == "EST");
+
+    // Ambiguous and nonexistent local times always take the full path.
+    reset_info_cache_stats();
+    li = z->get_info(local_days{2017_y/November/5} + hours{1} + minutes{30});
+    assert(li.result == local_info::ambiguous);
+    s = get_info_cache_stats();
+    assert(s.hits == 0);
+#endif  // HAS_STRING_VIEW
+
+    // A different zone in the same slot is a miss, not a wrong answer.
+    auto la = locate_zone("America/Los_Angeles");
+    reset_info_cache_stats();
+    assert(la->get_info(tp).offset == hours{-7});
+    assert(z->get_info(tp).offset == hours{-4});
+
+#if !USE_OS_TZDB
+    // Deleting a tzdb empties the cache, since a zone allocated later may reuse the
+    // address of one of its zones.
+    auto z2 = reload_tzdb().locate_zone("America/New_York");
+    z2->get_info(tp);
+    get_tzdb_list().erase_after(get_tzdb_list().begin());
+    reset_info_cache_stats();
+    z2->get_info(tp);
+    s = get_info_cache_stats();
+    assert(s.hits == 0);
+    assert(s.misses == 1);
+#endif
+}
+
+#else  // !USE_INFO_CACHE
+
+int
+main()
+{
+}
+
+#endif  // !USE_INFO_CACHE
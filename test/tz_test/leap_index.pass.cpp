@@ -0,0 +1,59 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Howard Hinnant
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Test that tzdb::leap_index agrees with a search over tzdb::leaps.
+
+#include "tz.h"
+#include <algorithm>
+#include <cassert>
+
+int
+main()
+{
+    using namespace date;
+    using namespace std::chrono;
+    auto const& db = get_tzdb();
+    auto const& leaps = db.leaps;
+    auto const& index = db.leap_index;
+    assert(index.dates.size() == leaps.size());
+    auto check = [&](sys_seconds tp)
+    {
+        auto n = std::upper_bound(leaps.begin(), leaps.end(), tp) - leaps.begin();
+        assert(index.count(tp) == static_cast<std::size_t>(n));
+        assert(index.count(tp + milliseconds{999}) == static_cast<std::size_t>(n));
+    };
+    for (auto const& l : leaps)
+        for (auto d = -2; d <= 2; ++d)
+            check(l.date() + seconds{d});
+    for (auto tp = sys_seconds{sys_days{1960_y/January/1}};
+              tp < sys_seconds{sys_days{2040_y/January/1}}; tp += hours{37} + seconds{13})
+        check(tp);
+
+    // 2016-12-31 23:59:60 UTC
+    auto leap = clock_cast<utc_clock>(sys_days{2017_y/January/1}) - seconds{1};
+    assert(is_leap_second(leap).first);
+    assert(is_leap_second(leap).second == seconds{27});
+    assert(!is_leap_second(leap - seconds{1}).first);
+    assert(is_leap_second(leap - seconds{1}).second == seconds{26});
+    assert(clock_cast<utc_clock>(sys_days{2017_y/January/1}).time_since_epoch() ==
+           sys_days{2017_y/January/1}.time_since_epoch() + seconds{27});
+}
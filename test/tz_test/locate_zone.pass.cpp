@@ -0,0 +1,53 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Howard Hinnant
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// const time_zone* tzdb::locate_zone(string_view tz_name) const;
+
+#include "tz.h"
+#include <cassert>
+#include <stdexcept>
+#include <string>
+
+int
+main()
+{
+    using namespace date;
+    auto const& db = get_tzdb();
+    for (auto const& z : db.zones)
+        assert(db.locate_zone(z.name()) == &z);
+#if !USE_OS_TZDB
+    for (auto const& l : db.links)
+        assert(db.locate_zone(l.name())->name() == l.target());
+#endif
+    for (auto name : {"", "America", "America/New_Yor", "America/New_Yorkk",
+                      "america/new_york"})
+    {
+        try
+        {
+            db.locate_zone(name);
+            assert(false);
+        }
+        catch (const std::runtime_error&)
+        {
+        }
+    }
+}
@@ -0,0 +1,86 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Howard Hinnant
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// packed_zoned_time and tzdb zone ids.
+
+#include "tz.h"
+#include <cassert>
+#include <stdexcept>
+#include <type_traits>
+
+int
+main()
+{
+    using namespace date;
+    using namespace std::chrono;
+
+    static_assert(sizeof(packed_zoned_time<>) == 8, "");
+    static_assert(sizeof(packed_zoned_time<milliseconds>) == 8, "");
+
+    auto& db = get_tzdb();
+    for (auto& z : db.zones)
+        assert(db.zone_from_id(db.zone_id(&z)) == &z);
+
+    auto ny = db.locate_zone("America/New_York");
+    auto tokyo = db.locate_zone("Asia/Tokyo");
+    zoned_time<seconds> zt{ny, sys_days{2017_y/mar/12} + hours{7}};
+    auto p = db.pack(zt);
+    assert(p.zone_id() == db.zone_id(ny));
+    assert(db.unpack(p) == zt);
+    assert(db.unpack(packed_zoned_time<>::from_bits(p.bits())) == zt);
+
+    zoned_time<milliseconds> before{tokyo, sys_days{1900_y/jan/1} - milliseconds{1}};
+    auto q = db.pack(before);
+    assert(db.unpack(q) == before);
+    assert(q.get_sys_time() < p.get_sys_time());
+    assert(q.bits() < p.bits());
+    auto r = db.pack(zoned_time<seconds>{tokyo, sys_days{1969_y/dec/31}});
+    auto e = db.pack(zoned_time<seconds>{ny, sys_days{1970_y/jan/1}});
+    assert(r.bits() < e.bits());
+    assert(e.bits() < p.bits());
+    assert(packed_zoned_time<>{}.get_sys_time() == sys_seconds{});
+
+    try
+    {
+        packed_zoned_time<microseconds>{0, sys_days{2020_y/jan/1}};
+        assert(false);
+    }
+    catch (const std::runtime_error&)
+    {
+    }
+    try
+    {
+        db.zone_id(nullptr);
+        assert(false);
+    }
+    catch (const std::runtime_error&)
+    {
+    }
+    try
+    {
+        db.zone_from_id(static_cast<std::uint16_t>(db.zones.size()));
+        assert(false);
+    }
+    catch (const std::runtime_error&)
+    {
+    }
+}
@@ -0,0 +1,142 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Howard Hinnant
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Parsing the tzdata files concurrently gives the same database as parsing them one
+// after another.
+
+#include "tz.h"
+#include <cassert>
+
+#if PARALLEL_TZDB_LOAD && !USE_OS_TZDB && !defined(_WIN32)
+
+#include "TempInstall.h"
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <string>
+
+#ifdef INSTALL
+#  define STRINGIZEIMP(x) #x
+#  define STRINGIZE(x) STRINGIZEIMP(x)
+#endif
+
+// Where the library looks for the database, unless set_install says otherwise.
+static
+std::string
+install_folder()
+{
+#ifdef INSTALL
+    return STRINGIZE(INSTALL) "/tzdata/";
+#else
+    return std::string(std::getenv("HOME")) + "/Downloads/tzdata/";
+#endif
+}
+
+static const char* const files[] =
+{
+    "africa", "antarctica", "asia", "australasia", "backward", "etcetera", "europe",
+    "pacificnew", "northamerica", "southamerica", "systemv", "leapseconds"
+};
+
+static
+std::string
+read_file(const std::string& path)
+{
+    std::ifstream in(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+template <class T>
+static
+std::string
+to_string(const T& x)
+{
+    std::ostringstream os;
+    os << x;
+    return os.str();
+}
+
+int
+main()
+{
+    using namespace date;
+    using namespace std::chrono;
+
+    // Each file is parsed by its own task.
+    auto& par = get_tzdb();
+
+    // The same files joined into one, which is then parsed by a single task, reading
+    // the lines in the order that the serial loader does.
+    auto install = install_folder();
+    TempInstall tmp("tzdb_parallel");
+    {
+        auto out = tmp.write("africa");
+        for (auto f : files)
+            out << read_file(install + f) << '\n';
+    }
+    tmp.write("version") << read_file(install + "version");
+    tmp.install();
+    auto& ser = reload_tzdb();
+    assert(&ser != &par);
+
+    assert(ser.version == par.version);
+    assert(ser.zones.size() == par.zones.size());
+    for (std::size_t i = 0; i < ser.zones.size(); ++i)
+    {
+        auto& zs = ser.zones[i];
+        auto& zp = par.zones[i];
+        assert(zs.name() == zp.name());
+        assert(to_string(zs) == to_string(zp));
+        for (auto tp = sys_seconds{sys_days{1850_y/jan/1}};
+                  tp < sys_days{2050_y/jan/1}; tp += days{97})
+        {
+            auto is = zs.get_info(tp);
+            auto ip = zp.get_info(tp);
+            assert(is.begin == ip.begin);
+            assert(is.end == ip.end);
+            assert(is.offset == ip.offset);
+            assert(is.save == ip.save);
+            assert(is.abbrev == ip.abbrev);
+        }
+    }
+    assert(ser.links.size() == par.links.size());
+    for (std::size_t i = 0; i < ser.links.size(); ++i)
+    {
+        assert(ser.links[i].name() == par.links[i].name());
+        assert(ser.links[i].target() == par.links[i].target());
+    }
+#if !MISSING_LEAP_SECONDS
+    assert(ser.leaps.size() == par.leaps.size());
+    for (std::size_t i = 0; i < ser.leaps.size(); ++i)
+        assert(ser.leaps[i].date() == par.leaps[i].date());
+#endif
+}
+
+#else  // !(PARALLEL_TZDB_LOAD && !USE_OS_TZDB && !defined(_WIN32))
+
+int
+main()
+{
+}
+
+#endif  // !(PARALLEL_TZDB_LOAD && !USE_OS_TZDB && !defined(_WIN32))
@@ -0,0 +1,54 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Howard Hinnant
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Initializing zones ahead of their first use.
+
+#include "tz.h"
+#include <cassert>
+#include <stdexcept>
+
+int
+main()
+{
+    using namespace date;
+    using namespace std::chrono;
+
+    auto& db = get_tzdb();
+    auto kolkata = db.locate_zone("Asia/Kolkata");
+    auto tokyo = db.locate_zone("Asia/Tokyo");
+    db.prewarm({"Asia/Kolkata"}, 2);
+    assert(kolkata->is_initialized());
+
+    try
+    {
+        db.prewarm({"Asia/Tokyo", "Not/A_Zone"});
+        assert(false);
+    }
+    catch (const std::runtime_error&)
+    {
+    }
+
+    db.prewarm_all();
+    for (auto& z : db.zones)
+        assert(z.is_initialized());
+    assert(tokyo->get_info(sys_days{2020_y/jan/1}).offset == hours{9});
+}
@@ -0,0 +1,60 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Howard Hinnant
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Deferred deletion of retired databases while readers hold a tzdb_list::pin.
+
+#include "tz.h"
+#include <cassert>
+
+int
+main()
+{
+    using namespace date;
+
+    auto& list = get_tzdb_list();
+    assert(list.reclaim() == 0);
+    {
+        tzdb_list::pin p1;
+        tzdb_list::pin p2;
+        assert(list.reclaim() == 0);
+    }
+#if !USE_OS_TZDB
+    const time_zone* z;
+    {
+        tzdb_list::pin p;
+        z = get_tzdb().locate_zone("America/New_York");
+        reload_tzdb();
+        list.retire_after(list.begin());
+        assert(std::next(list.begin()) == list.end());
+        assert(list.reclaim() == 1);
+        assert(z->name() == "America/New_York");
+    }
+    assert(list.reclaim() == 0);
+    {
+        tzdb_list::pin p;
+        z = get_tzdb().locate_zone("America/New_York");
+    }
+    reload_tzdb();
+    list.retire_after(list.begin());
+    assert(list.reclaim() == 0);
+#endif  // !USE_OS_TZDB
+}
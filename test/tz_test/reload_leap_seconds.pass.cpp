@@ -0,0 +1,143 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Howard Hinnant
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// sys_seconds reload_leap_seconds(const std::string& path);
+// sys_seconds leap_seconds_expiration();
+
+#include "tz.h"
+#include <cassert>
+
+#if !defined(_WIN32)
+
+#include "TempInstall.h"
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+int
+main()
+{
+    using namespace std::chrono;
+    using namespace date;
+    TempInstall tmp("reload_leap_seconds");
+    tmp.remember("leap-seconds.list");
+    const std::string path = tmp.dir() + "/leap-seconds.list";
+    auto const& db = get_tzdb();
+    assert(&detail::current_leaps() == &db.leap_index);
+    assert(leap_seconds_expiration() == sys_seconds::min());
+    auto n = static_cast<long long>(db.leaps.size());
+    auto after = sys_days{2030_y/January/1} + hours{1};
+    assert(clock_cast<utc_clock>(after).time_since_epoch() ==
+           after.time_since_epoch() + seconds{n});
+
+    // The leap seconds of the tzdb, with one more on 2030-01-01, and blank lines
+    {
+        std::ofstream out(path);
+        out << "#\tA comment\n#$\t3960835200\n#@\t3991593600\n#\n\n";
+        out << "2272060800\t10\t# 1 Jan 1972\n \t\n";
+        const seconds ntp_epoch = sys_days{1970_y/January/1} - sys_days{1900_y/January/1};
+        for (long long i = 0; i < n; ++i)
+            out << (db.leaps[static_cast<std::size_t>(i)].date().time_since_epoch() +
+                    ntp_epoch).count() << '\t' << 11 + i << '\n';
+        out << (sys_days{2030_y/January/1}.time_since_epoch() + ntp_epoch).count()
+            << '\t' << 11 + n << "\t# 1 Jan 2030\n";
+    }
+    auto expires = reload_leap_seconds(path);
+    assert(expires == sys_days{2026_y/June/28});
+    assert(leap_seconds_expiration() == expires);
+    assert(db.leaps.size() == static_cast<std::size_t>(n));
+    assert(clock_cast<utc_clock>(after).time_since_epoch() ==
+           after.time_since_epoch() + seconds{n + 1});
+    auto leap = clock_cast<utc_clock>(sys_days{2030_y/January/1}) - seconds{1};
+    assert(is_leap_second(leap).first);
+    assert(clock_cast<gps_clock>(after) ==
+           clock_cast<gps_clock>(sys_days{2017_y/January/1}) +
+           (sys_days{2030_y/January/1} - sys_days{2017_y/January/1}) + hours{1} +
+           seconds{n + 1 - 27});
+    sys_seconds batch[2] = {sys_days{2017_y/January/1}, after};
+    utc_seconds ut[2];
+    clock_cast<utc_clock>(batch, batch + 2, ut);
+    assert(ut[1] == clock_cast<utc_clock>(after));
+
+    // An invalid list leaves the table in place
+    {
+        std::ofstream out(path);
+        out << "2272060800\t10\n2287785600\t12\n";
+    }
+    try
+    {
+        reload_leap_seconds(path);
+        assert(false);
+    }
+    catch (const std::runtime_error&)
+    {
+    }
+    assert(leap_seconds_expiration() == expires);
+    std::remove(path.c_str());
+    try
+    {
+        reload_leap_seconds(path);
+        assert(false);
+    }
+    catch (const std::runtime_error&)
+    {
+    }
+
+    // A list that is older than the leap seconds in use is ignored:  one that stops at
+    // an earlier leap second, and one that ends with the same one and expires sooner
+    {
+        std::ofstream out(path);
+        out << "#@\t3991593600\n2272060800\t10\n";
+    }
+    assert(reload_leap_seconds(path) == expires);
+    assert(leap_seconds_expiration() == expires);
+    assert(clock_cast<utc_clock>(after).time_since_epoch() ==
+           after.time_since_epoch() + seconds{n + 1});
+    {
+        std::ofstream out(path);
+        out << "#@\t3960835200\n2272060800\t10\n";
+        out << (sys_days{2030_y/January/1}.time_since_epoch() +
+                (sys_days{1970_y/January/1} - sys_days{1900_y/January/1})).count()
+            << "\t11\n";
+    }
+    assert(reload_leap_seconds(path) == expires);
+    assert(leap_seconds_expiration() == expires);
+
+#if !USE_OS_TZDB
+    // A new database keeps the newer leap seconds loaded above
+    auto const& db2 = reload_tzdb();
+    assert(&detail::current_leaps() != &db2.leap_index);
+    assert(leap_seconds_expiration() == expires);
+    assert(clock_cast<utc_clock>(after).time_since_epoch() ==
+           after.time_since_epoch() + seconds{n + 1});
+#endif
+}
+
+#else  // defined(_WIN32)
+
+int
+main()
+{
+}
+
+#endif  // defined(_WIN32)
@@ -0,0 +1,238 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Howard Hinnant
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// A database loaded from the tzdb snapshot matches the one parsed from the text, and
+// the snapshot is rebuilt when the text changes.
+
+#include "tz.h"
+#include <cassert>
+
+#if TZDB_SNAPSHOT && !USE_OS_TZDB && !defined(_WIN32)
+
+#include "TempInstall.h"
+#include "tz_private.h"
+#include <cstdio>
+#include <cstdlib>
+#include <dirent.h>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+
+static
+void
+write_europe(TempInstall& tmp, const std::string& offset)
+{
+    tmp.write("europe")
+        << "Rule EU 1977 1980 - Apr Sun>=1 1:00u 1:00 S\n"
+           "Rule EU 1977 only - Sep lastSun 1:00u 0 -\n"
+           "Rule EU 1978 only - Oct 1 1:00u 0 -\n"
+           "Rule EU 1979 1995 - Sep lastSun 1:00u 0 -\n"
+           "Rule EU 1981 max - Mar lastSun 1:00u 1:00 S\n"
+           "Rule EU 1996 max - Oct lastSun 1:00u 0 -\n"
+           "Zone Europe/Test 0:53:28 - LMT 1893 Apr\n"
+           "\t\t1:00 - CET 1977\n"
+           "\t\t" << offset << " EU CE%sT\n";
+}
+
+static
+void
+write_tzdata(TempInstall& tmp)
+{
+    tmp.write("version") << "2001a\n";
+    tmp.write("northamerica")
+        << "Rule US 1918 1919 - Mar lastSun 2:00 1:00 D\n"
+           "Rule US 1918 1919 - Oct lastSun 2:00 0 S\n"
+           "Rule US 1967 2006 - Oct lastSun 2:00 0 S\n"
+           "Rule US 1967 1973 - Apr lastSun 2:00 1:00 D\n"
+           "Rule US 1974 only - Jan 6 2:00 1:00 D\n"
+           "Rule US 1975 only - Feb lastSun 2:00 1:00 D\n"
+           "Rule US 1976 1986 - Apr lastSun 2:00 1:00 D\n"
+           "Rule US 1987 2006 - Apr Sun>=1 2:00 1:00 D\n"
+           "Rule US 2007 max - Mar Sun>=8 2:00 1:00 D\n"
+           "Rule US 2007 max - Nov Sun>=1 2:00 0 S\n"
+           "Zone America/Test -4:56:02 - LMT 1883 Nov 18 12:03:58\n"
+           "\t\t-5:00 US E%sT 1920\n"
+           "\t\t-5:00 - EST 1967\n"
+           "\t\t-5:00 US E%sT\n";
+    tmp.write("backward") << "Link America/Test US/Test\n";
+    tmp.write("leapseconds")
+        << "Leap 1972 Jun 30 23:59:60 + S\n"
+           "Leap 1972 Dec 31 23:59:60 + S\n"
+           "Leap 2016 Dec 31 23:59:60 + S\n";
+    write_europe(tmp, "1:00");
+}
+
+template <class T>
+static
+std::string
+to_string(const T& x)
+{
+    std::ostringstream os;
+    os << x;
+    return os.str();
+}
+
+static
+void
+check_same_zones(const date::tzdb& x, const date::tzdb& y)
+{
+    using namespace date;
+    using namespace std::chrono;
+    assert(x.version == y.version);
+    assert(x.zones.size() == y.zones.size());
+    for (std::size_t i = 0; i < x.zones.size(); ++i)
+    {
+        auto& zx = x.zones[i];
+        auto& zy = y.zones[i];
+        assert(zx.name() == zy.name());
+        assert(to_string(zx) == to_string(zy));
+        // Beyond the compiled years too, where the rules are walked.
+        for (auto tp = sys_seconds{sys_days{1850_y/jan/1}};
+                  tp < sys_days{2300_y/jan/1}; tp += days{61})
+        {
+            auto ix = zx.get_info(tp);
+            auto iy = zy.get_info(tp);
+            assert(ix.begin == iy.begin);
+            assert(ix.end == iy.end);
+            assert(ix.offset == iy.offset);
+            assert(ix.save == iy.save);
+            assert(ix.abbrev == iy.abbrev);
+            auto lt = local_seconds{tp.time_since_epoch()};
+            assert(to_string(zx.get_info(lt)) == to_string(zy.get_info(lt)));
+        }
+    }
+}
+
+// The snapshot files in folder.
+static
+std::vector<std::string>
+list_snapshots(const std::string& folder)
+{
+    std::vector<std::string> r;
+    if (auto d = opendir(folder.c_str()))
+    {
+        while (auto e = readdir(d))
+        {
+            std::string name = e->d_name;
+            if (name.size() > 9 && name.compare(name.size() - 9, 9, ".snapshot") == 0)
+                r.push_back(folder + '/' + name);
+        }
+        closedir(d);
+    }
+    return r;
+}
+
+int
+main()
+{
+    using namespace date;
+    using namespace std::chrono;
+
+    TempInstall tmp("tzdb_snapshot");
+    TempInstall cache("tzdb_cache");
+    setenv("XDG_CACHE_HOME", cache.dir().c_str(), 1);
+    write_tzdata(tmp);
+    tmp.install();
+
+    // Parsed from the text, which starts writing the snapshot to the cache folder and
+    // leaves the install folder alone.  The zones aren't initialized to write it.
+    auto& parsed = get_tzdb();
+    assert(parsed.snapshot_data == nullptr);
+    assert(!parsed.zones.front().is_initialized());
+    detail::wait_for_snapshot();
+    auto snapshots = list_snapshots(cache.dir() + "/date");
+    assert(snapshots.size() == 1);
+    cache.remember(snapshots.front().substr(cache.dir().size() + 1));
+    cache.remember("date");
+    assert(!std::ifstream(tmp.dir() + "/tzdb.snapshot").is_open());
+
+    // Loaded from the snapshot.  Zones are decoded from it on first use, already
+    // adjusted to their rules and compiled.
+    auto& loaded = reload_tzdb();
+    assert(&loaded != &parsed);
+    assert(loaded.snapshot_data != nullptr);
+    assert(!loaded.zones.front().is_initialized());
+    check_same_zones(parsed, loaded);
+    assert(loaded.zones.front().is_initialized());
+    assert(loaded.links.size() == parsed.links.size());
+    for (std::size_t i = 0; i < loaded.links.size(); ++i)
+    {
+        assert(loaded.links[i].name() == parsed.links[i].name());
+        assert(loaded.links[i].target() == parsed.links[i].target());
+    }
+    assert(loaded.locate_zone("US/Test") == loaded.locate_zone("America/Test"));
+#if !MISSING_LEAP_SECONDS
+    assert(loaded.leaps.size() == 3);
+    assert(loaded.leaps.size() == parsed.leaps.size());
+    for (std::size_t i = 0; i < loaded.leaps.size(); ++i)
+        assert(loaded.leaps[i].date() == parsed.leaps[i].date());
+#endif
+
+    // A damaged zone doesn't match the checksum, so the text is parsed again and the
+    // snapshot rewritten.  The damaged copy is renamed into place, since loaded still
+    // maps the old file.
+    std::string good;
+    {
+        std::ifstream in(snapshots.front(), std::ios::binary);
+        good.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+    auto bad = good;
+    bad[bad.size() - 3] ^= 0x20;
+    std::ofstream(snapshots.front() + ".bad", std::ios::binary) << bad;
+    std::rename((snapshots.front() + ".bad").c_str(), snapshots.front().c_str());
+    auto& repaired = reload_tzdb();
+    assert(repaired.snapshot_data == nullptr);
+    check_same_zones(parsed, repaired);
+    detail::wait_for_snapshot();
+    {
+        std::ifstream in(snapshots.front(), std::ios::binary);
+        assert(std::string(std::istreambuf_iterator<char>(in),
+                           std::istreambuf_iterator<char>()) == good);
+    }
+
+    // Changing a file changes the stamp, so the text is parsed again and the snapshot
+    // rewritten, even when the size stays the same.
+    auto summer = sys_days{2020_y/jul/1};
+    assert(loaded.locate_zone("Europe/Test")->get_info(summer).offset == hours{2});
+    write_europe(tmp, "2:00");
+    auto& changed = reload_tzdb();
+    assert(changed.locate_zone("Europe/Test")->get_info(summer).offset == hours{3});
+    assert(changed.locate_zone("Europe/Test")->get_info(summer).abbrev == "CEST");
+    detail::wait_for_snapshot();
+    assert(changed.snapshot_data == nullptr);
+    auto& reloaded = reload_tzdb();
+    assert(reloaded.snapshot_data != nullptr);
+    assert(reloaded.locate_zone("Europe/Test")->get_info(summer).offset == hours{3});
+    check_same_zones(changed, reloaded);
+    assert(list_snapshots(cache.dir() + "/date") == snapshots);
+}
+
+#else  // !(TZDB_SNAPSHOT && !USE_OS_TZDB && !defined(_WIN32))
+
+int
+main()
+{
+}
+
+#endif  // !(TZDB_SNAPSHOT && !USE_OS_TZDB && !defined(_WIN32))
@@ -0,0 +1,149 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Howard Hinnant
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Enumerating a time_zone's transitions over a range.
+
+#include "tz.h"
+#include <cassert>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+#if HAS_STRING_VIEW && USE_OS_TZDB && !defined(_WIN32)
+
+#include "tz_private.h"
+
+static
+void
+put_be(std::string& s, std::int64_t x, int n)
+{
+    for (int k = n - 1; k >= 0; --k)
+        s += static_cast<char>(x >> 8*k & 0xFF);
+}
+
+// A version 1 TZif file, which has no footer, for a zone that goes from EST to EDT at
+// the start of 2000 and stays there.
+static
+std::string
+no_footer_tzif()
+{
+    std::string s = "TZif";
+    s.append(16, '\0');
+    for (auto n : {0, 0, 0, 1, 2, 8})
+        put_be(s, n, 4);
+    put_be(s, 946684800, 4);
+    s += '\1';
+    put_be(s, -18000, 4);
+    s += '\0';
+    s += '\0';
+    put_be(s, -14400, 4);
+    s += '\1';
+    s += '\4';
+    s.append("EST\0EDT\0", 8);
+    return s;
+}
+
+#endif  // HAS_STRING_VIEW && USE_OS_TZDB && !defined(_WIN32)
+
+int
+main()
+{
+#if HAS_STRING_VIEW
+    using namespace date;
+    using namespace std::chrono;
+
+    auto ny = locate_zone("America/New_York");
+    auto r = ny->transitions(sys_days{2017_y/jan/1}, sys_days{2018_y/jan/1});
+    auto i = r.begin();
+    assert(i != r.end());
+    assert(i->when == sys_days{2017_y/mar/12} + hours{7});
+    assert(i->old_offset == hours{-5});
+    assert(i->new_offset == hours{-4});
+    assert(i->save != minutes{0});
+    assert(i->abbrev == "EDT");
+    ++i;
+    assert(i->when == sys_days{2017_y/nov/5} + hours{6});
+    assert(i->old_offset == hours{-4});
+    assert(i->new_offset == hours{-5});
+    assert(i->save == minutes{0});
+    assert(i->abbrev == "EST");
+    assert(++i == r.end());
+
+    // from is inclusive and to is exclusive
+    auto dst = sys_seconds{sys_days{2017_y/mar/12} + hours{7}};
+    assert(std::distance(ny->transitions(dst, dst + seconds{1}).begin(),
+                         ny->transitions(dst, dst + seconds{1}).end()) == 1);
+    auto empty = ny->transitions(dst + seconds{1}, sys_days{2017_y/nov/5});
+    assert(empty.begin() == empty.end());
+
+    // Past the last transition listed in the data
+    auto far = ny->transitions(sys_days{2100_y/jan/1}, sys_days{2101_y/jan/1});
+    assert(std::distance(far.begin(), far.end()) == 2);
+    assert(far.begin()->when == sys_days{2100_y/mar/14} + hours{7});
+
+    auto kolkata = locate_zone("Asia/Kolkata");
+    auto none = kolkata->transitions(sys_days{2000_y/jan/1}, sys_days{2020_y/jan/1});
+    assert(none.begin() == none.end());
+
+    // Ranges reaching the ends of time
+    auto tokyo = locate_zone("Asia/Tokyo");
+    none = tokyo->transitions(sys_days{2020_y/jan/1}, sys_seconds::max());
+    assert(none.begin() == none.end());
+    none = tokyo->transitions(sys_days{2020_y/jan/1},
+                              sys_days{year::max()/dec/31} + days{1});
+    assert(none.begin() == none.end());
+    auto utc = locate_zone("UTC");
+    none = utc->transitions(sys_seconds::min(), sys_seconds::max());
+    assert(none.begin() == none.end());
+    auto end = ny->transitions(sys_days{(year::max() - years{2})/jan/1},
+                               sys_seconds::max());
+    auto n = std::distance(end.begin(), end.end());
+    assert(n == 4 || n == 5 || n == 6);
+    sys_seconds prev{};
+    for (auto& t : end)
+    {
+        assert(t.when > prev);
+        assert(t.when < sys_days{year::max()/dec/31});
+        prev = t.when;
+    }
+    auto begin = ny->transitions(sys_seconds::min(), sys_days{1900_y/jan/1});
+    assert(std::distance(begin.begin(), begin.end()) == 1);
+    assert(begin.begin()->when == sys_days{1883_y/nov/18} + hours{17});
+    assert(begin.begin()->abbrev == "EST");
+
+#if USE_OS_TZDB && !defined(_WIN32)
+    // No footer, so the last transition in the file is the last one there is.
+    const std::string file = "/tmp/transitions_no_footer.tzif";
+    std::ofstream(file, std::ios::binary) << no_footer_tzif();
+    time_zone nf{"../../../../../../../.." + file, detail::undocumented{}};
+    auto all = nf.transitions(sys_seconds::min(), sys_seconds::max());
+    assert(std::distance(all.begin(), all.end()) == 1);
+    assert(all.begin()->when == sys_days{2000_y/jan/1});
+    assert(all.begin()->abbrev == "EDT");
+    none = nf.transitions(sys_days{2000_y/jan/1} + seconds{1}, sys_seconds::max());
+    assert(none.begin() == none.end());
+    std::remove(file.c_str());
+#endif  // USE_OS_TZDB && !defined(_WIN32)
+#endif  // HAS_STRING_VIEW
+}
@@ -0,0 +1,106 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Howard Hinnant
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// With USE_TZDATA_ZI, tzdb::locate_zone finds the zones that tzdata.zi lists, and
+// the zone files it doesn't list under the same names the zoneinfo scan would give.
+
+#include "tz.h"
+#include <cassert>
+
+#if USE_OS_TZDB && USE_TZDATA_ZI && !defined(_WIN32)
+
+#include <algorithm>
+#include <stdexcept>
+
+int
+main()
+{
+    using namespace date;
+    auto const& db = get_tzdb();
+
+    // A listed name
+    auto berlin = db.locate_zone("Europe/Berlin");
+    assert(berlin >= db.zones.data() && berlin < db.zones.data() + db.zones.size());
+    assert(berlin->name() == "Europe/Berlin");
+
+    // A listed name is found only if it has a zone file, so every zone found loads
+    for (auto const& z : db.zones)
+    {
+        const time_zone* found = nullptr;
+        try
+        {
+            found = db.locate_zone(z.name());
+        }
+        catch (const std::runtime_error&)
+        {
+        }
+        if (found != nullptr)
+        {
+            assert(found == &z);
+            found->get_info(sys_days{2020_y/January/1});
+        }
+    }
+
+    // Names the zoneinfo scan skips, or that leave the zoneinfo folder
+    for (auto name : {"posix/Europe/Berlin", "right/Europe/Berlin", "posixrules",
+                      "../zoneinfo/Europe/Berlin", "Europe/../Europe/Berlin",
+                      "Europe//Berlin", "/Europe/Berlin", "Europe/Berlin/",
+                      ".hidden", "tzdata.zi", "zone.tab", "Factory"})
+    {
+        try
+        {
+            db.locate_zone(name);
+            assert(false);
+        }
+        catch (const std::runtime_error&)
+        {
+        }
+    }
+
+    // An unlisted zone file, if the system has one, is found once and then reused
+    const time_zone* z = nullptr;
+    try
+    {
+        z = db.locate_zone("localtime");
+    }
+    catch (const std::runtime_error&)
+    {
+    }
+    if (z != nullptr)
+    {
+        assert(std::find_if(db.zones.begin(), db.zones.end(),
+                            [](const time_zone& x) {return x.name() == "localtime";})
+               == db.zones.end());
+        assert(z->name() == "localtime");
+        assert(db.locate_zone("localtime") == z);
+        z->get_info(sys_days{2020_y/January/1});
+    }
+}
+
+#else  // !(USE_OS_TZDB && USE_TZDATA_ZI && !defined(_WIN32))
+
+int
+main()
+{
+}
+
+#endif  // !(USE_OS_TZDB && USE_TZDATA_ZI && !defined(_WIN32))
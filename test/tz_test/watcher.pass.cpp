@@ -0,0 +1,91 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Howard Hinnant
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Reloading the database when the install folder changes.
+
+#include "tz.h"
+#include <cassert>
+
+#if USE_TZDB_WATCHER && !USE_OS_TZDB
+
+#include "TempInstall.h"
+#include <chrono>
+#include <iterator>
+#include <string>
+#include <thread>
+
+static
+void
+write_tzdata(TempInstall& tmp, const std::string& version, const std::string& offset)
+{
+    tmp.write("version") << version << '\n';
+    tmp.write("etcetera")
+        << "Rule Test 1990 max - Mar lastSun 2:00 1:00 D\n"
+           "Rule Test 1990 max - Oct lastSun 2:00 0 S\n"
+           "Zone Etc/Test " << offset << " Test T%sT\n";
+}
+
+int
+main()
+{
+    using namespace date;
+    using namespace std::chrono;
+
+    TempInstall tmp("tzdb_watcher");
+    write_tzdata(tmp, "2000a", "1:00");
+    tmp.install();
+    assert(get_tzdb().version == "2000a");
+    start_tzdb_watcher(milliseconds{50});
+
+    auto old = locate_zone("Etc/Test");
+    write_tzdata(tmp, "2000b", "-10:00");
+    auto deadline = steady_clock::now() + seconds{10};
+    while (get_tzdb().version != "2000b" && steady_clock::now() < deadline)
+        std::this_thread::sleep_for(milliseconds{10});
+    assert(get_tzdb().version == "2000b");
+    stop_tzdb_watcher();
+    assert(locate_zone("Etc/Test")->get_info(sys_days{2000_y/jan/1}).offset == hours{-10});
+    assert(locate_zone("Etc/Test")->get_info(sys_days{2300_y/jul/1}).offset == hours{-9});
+
+    // The replaced database stays in the list, so its zones, and the rules they walk,
+    // are still there.
+    auto& list = get_tzdb_list();
+    assert(std::next(list.begin())->version == "2000a");
+    auto i = old->get_info(sys_days{2300_y/jul/1});
+    assert(i.offset == hours{2});
+    assert(i.abbrev == "TDT");
+    assert(old->get_info(sys_days{1900_y/jul/1}).offset == hours{1});
+
+    // Until the application frees it.
+    list.retire_after(list.begin());
+    assert(list.reclaim() == 0);
+    assert(std::next(list.begin()) == list.end());
+}
+
+#else  // !(USE_TZDB_WATCHER && !USE_OS_TZDB)
+
+int
+main()
+{
+}
+
+#endif  // !(USE_TZDB_WATCHER && !USE_OS_TZDB)